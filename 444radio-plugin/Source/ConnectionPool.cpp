@@ -0,0 +1,356 @@
+#include "ConnectionPool.h"
+
+#if JUCE_WINDOWS
+#include <windows.h>
+#include <winhttp.h>
+#include <map>
+#include <string>
+
+// Older SDKs don't declare the HTTP/2 opt-in (Windows 10 1607+)
+#ifndef WINHTTP_OPTION_ENABLE_HTTP_PROTOCOL
+ #define WINHTTP_OPTION_ENABLE_HTTP_PROTOCOL 133
+#endif
+#ifndef WINHTTP_PROTOCOL_FLAG_HTTP2
+ #define WINHTTP_PROTOCOL_FLAG_HTTP2 0x1
+#endif
+// System proxy settings incl. PAC / WPAD (Windows 8.1+)
+#ifndef WINHTTP_ACCESS_TYPE_AUTOMATIC_PROXY
+ #define WINHTTP_ACCESS_TYPE_AUTOMATIC_PROXY 4
+#endif
+
+//==============================================================================
+//  WinHTTP backend: one session, one connect handle per origin.
+//  WinHTTP keeps idle sockets alive inside the session, so closing a request
+//  handle hands its connection back for the next request to the same host.
+//==============================================================================
+struct ConnectionPool::Pimpl
+{
+    explicit Pimpl (ConnectionPool& o) : owner (o)
+    {
+        // Same proxy the system (and juce::URL) uses, auto-config scripts
+        // included; older Windows only knows WinHTTP's static setting.
+        session = WinHttpOpen (L"444Radio-Plugin/1.0",
+                               WINHTTP_ACCESS_TYPE_AUTOMATIC_PROXY,
+                               WINHTTP_NO_PROXY_NAME, WINHTTP_NO_PROXY_BYPASS, 0);
+
+        if (session == nullptr)
+            session = WinHttpOpen (L"444Radio-Plugin/1.0",
+                                   WINHTTP_ACCESS_TYPE_DEFAULT_PROXY,
+                                   WINHTTP_NO_PROXY_NAME, WINHTTP_NO_PROXY_BYPASS, 0);
+
+        if (session == nullptr)
+        {
+            DBG ("444 Radio: WinHttpOpen failed — " + juce::String ((int) GetLastError()));
+            return;
+        }
+
+        DWORD protocols = WINHTTP_PROTOCOL_FLAG_HTTP2;
+        if (! WinHttpSetOption (session, WINHTTP_OPTION_ENABLE_HTTP_PROTOCOL,
+                                &protocols, sizeof (protocols)))
+            DBG ("444 Radio: HTTP/2 not available — using HTTP/1.1 keep-alive");
+
+        WinHttpSetTimeouts (session, 0, kConnectionTimeoutMs,
+                            kConnectionTimeoutMs, kConnectionTimeoutMs);
+
+        // Every fresh TCP connect shows up here → handshake count
+        WinHttpSetStatusCallback (session, &Pimpl::statusCallback,
+                                  WINHTTP_CALLBACK_FLAG_CONNECTED_TO_SERVER, 0);
+    }
+
+    ~Pimpl()
+    {
+        for (auto& c : connections)
+            WinHttpCloseHandle (c.second);
+
+        if (session != nullptr)
+            WinHttpCloseHandle (session);
+    }
+
+    static void CALLBACK statusCallback (HINTERNET, DWORD_PTR context, DWORD status, LPVOID, DWORD)
+    {
+        if (status == WINHTTP_CALLBACK_STATUS_CONNECTED_TO_SERVER && context != 0)
+            reinterpret_cast<Pimpl*> (context)->owner.recordConnectionOpened();
+    }
+
+    HINTERNET getConnection (const std::wstring& host, INTERNET_PORT port)
+    {
+        const juce::ScopedLock sl (connectionsLock);
+
+        auto key = host + L":" + std::to_wstring (port);
+        auto it  = connections.find (key);
+        if (it != connections.end())
+            return it->second;
+
+        auto connection = WinHttpConnect (session, host.c_str(), port, 0);
+        if (connection != nullptr)
+            connections[key] = connection;
+
+        return connection;
+    }
+
+    bool fetchToFile (const juce::String& url, const juce::File& dest,
+                      Cancellation& cancellation)
+    {
+        if (session == nullptr)
+            return false;
+
+        auto wideUrl = url.toWideCharPointer();
+
+        URL_COMPONENTS parts {};
+        parts.dwStructSize      = sizeof (parts);
+        parts.dwHostNameLength  = (DWORD) -1;
+        parts.dwUrlPathLength   = (DWORD) -1;
+        parts.dwExtraInfoLength = (DWORD) -1;
+
+        if (! WinHttpCrackUrl (wideUrl, 0, 0, &parts))
+        {
+            DBG ("444 Radio: could not parse URL — " + url);
+            return false;
+        }
+
+        std::wstring host (parts.lpszHostName, parts.dwHostNameLength);
+        std::wstring path (parts.lpszUrlPath, parts.dwUrlPathLength + parts.dwExtraInfoLength);
+        if (path.empty()) path = L"/";
+
+        auto connection = getConnection (host, parts.nPort);
+        if (connection == nullptr)
+            return false;
+
+        auto startMs = juce::Time::getMillisecondCounterHiRes();
+
+        auto request = WinHttpOpenRequest (connection, L"GET", path.c_str(), nullptr,
+                                           WINHTTP_NO_REFERER, WINHTTP_DEFAULT_ACCEPT_TYPES,
+                                           parts.nScheme == INTERNET_SCHEME_HTTPS ? WINHTTP_FLAG_SECURE : 0);
+        if (request == nullptr)
+            return false;
+
+        // Closing the request from the cancelling thread unblocks a pending read
+        if (! cancellation.setAbortAction ([request] { WinHttpCloseHandle (request); }))
+        {
+            WinHttpCloseHandle (request);
+            return false;
+        }
+
+        bool        ok    = false;
+        juce::int64 bytes = 0;
+        double      ttfb  = 0.0;
+
+        if (WinHttpSendRequest (request, WINHTTP_NO_ADDITIONAL_HEADERS, 0,
+                                WINHTTP_NO_REQUEST_DATA, 0, 0, reinterpret_cast<DWORD_PTR> (this))
+             && WinHttpReceiveResponse (request, nullptr))
+        {
+            ttfb = juce::Time::getMillisecondCounterHiRes() - startMs;
+
+            DWORD status = 0, statusSize = sizeof (status);
+            WinHttpQueryHeaders (request, WINHTTP_QUERY_STATUS_CODE | WINHTTP_QUERY_FLAG_NUMBER,
+                                 WINHTTP_HEADER_NAME_BY_INDEX, &status, &statusSize,
+                                 WINHTTP_NO_HEADER_INDEX);
+
+            if (status >= 200 && status < 300)
+            {
+                juce::FileOutputStream out (dest);
+
+                if (out.openedOk())
+                {
+                    out.setPosition (0);
+                    out.truncate();
+
+                    char buf[65536];
+                    bool readFailed = false;
+
+                    while (! cancellation.isCancelled())
+                    {
+                        DWORD got = 0;
+                        if (! WinHttpReadData (request, buf, sizeof (buf), &got))
+                        {
+                            readFailed = true;
+                            break;
+                        }
+
+                        if (got == 0) break;
+                        out.write (buf, got);
+                        bytes += got;
+                    }
+
+                    out.flush();
+                    ok = ! readFailed && ! cancellation.isCancelled() && bytes > 0;
+                }
+            }
+            else
+            {
+                DBG ("444 Radio: HTTP " + juce::String ((int) status) + " — " + url);
+            }
+        }
+
+        // Connection goes back to the session's idle pool (unless cancelled,
+        // in which case the handle is already closed)
+        if (cancellation.clearAbortAction())
+            WinHttpCloseHandle (request);
+
+        owner.recordRequest (ok, ttfb, bytes);
+        return ok;
+    }
+
+    ConnectionPool&                   owner;
+    HINTERNET                         session = nullptr;
+    juce::CriticalSection             connectionsLock;
+    std::map<std::wstring, HINTERNET> connections;
+};
+
+#else
+
+//==============================================================================
+//  Portable backend: juce::WebInputStream (NSURLSession on macOS)
+//==============================================================================
+struct ConnectionPool::Pimpl
+{
+    explicit Pimpl (ConnectionPool& o) : owner (o) {}
+
+    bool fetchToFile (const juce::String& url, const juce::File& dest,
+                      Cancellation& cancellation)
+    {
+        auto startMs = juce::Time::getMillisecondCounterHiRes();
+
+        juce::WebInputStream stream (juce::URL (url), false);
+        stream.withConnectionTimeout (kConnectionTimeoutMs);
+
+        // WebInputStream::cancel() unblocks a pending connect or read
+        if (! cancellation.setAbortAction ([&stream] { stream.cancel(); }))
+            return false;
+
+        auto connected = stream.connect (nullptr);
+        owner.recordConnectionOpened();
+
+        bool        ok    = false;
+        juce::int64 bytes = 0;
+        double      ttfb  = juce::Time::getMillisecondCounterHiRes() - startMs;
+        auto        status = stream.getStatusCode();
+
+        if (connected && status >= 200 && status < 300 && ! cancellation.isCancelled())
+        {
+            juce::FileOutputStream out (dest);
+
+            if (out.openedOk())
+            {
+                out.setPosition (0);
+                out.truncate();
+
+                char buf[65536];
+                while (! cancellation.isCancelled())
+                {
+                    auto n = stream.read (buf, sizeof (buf));
+                    if (n <= 0) break;
+                    out.write (buf, static_cast<size_t> (n));
+                    bytes += n;
+                }
+
+                out.flush();
+                ok = ! cancellation.isCancelled() && bytes > 0;
+            }
+        }
+        else if (connected)
+        {
+            DBG ("444 Radio: HTTP " + juce::String (status) + " — " + url);
+        }
+
+        cancellation.clearAbortAction();   // `stream` is about to go away
+        owner.recordRequest (ok, ttfb, bytes);
+        return ok;
+    }
+
+    ConnectionPool& owner;
+};
+
+#endif
+
+//==============================================================================
+ConnectionPool::ConnectionPool()
+    : pimpl (std::make_unique<Pimpl> (*this))
+{
+}
+
+ConnectionPool::~ConnectionPool()
+{
+    DBG ("444 Radio: connection pool closed — " + getMetrics().toString());
+}
+
+bool ConnectionPool::fetchToFile (const juce::String& url, const juce::File& dest,
+                                  Cancellation& cancellation)
+{
+    dest.getParentDirectory().createDirectory();
+    return pimpl->fetchToFile (url, dest, cancellation);
+}
+
+//==============================================================================
+void ConnectionPool::Cancellation::cancel()
+{
+    const juce::ScopedLock sl (lock);
+    cancelled = true;
+
+    if (abortAction != nullptr)
+    {
+        abortAction();
+        abortAction = nullptr;
+    }
+}
+
+bool ConnectionPool::Cancellation::setAbortAction (std::function<void()> action)
+{
+    const juce::ScopedLock sl (lock);
+
+    if (cancelled)
+        return false;
+
+    abortAction = std::move (action);
+    return true;
+}
+
+bool ConnectionPool::Cancellation::clearAbortAction()
+{
+    const juce::ScopedLock sl (lock);
+
+    auto stillSet = abortAction != nullptr;
+    abortAction = nullptr;
+    return stillSet;
+}
+
+ConnectionPool::Metrics ConnectionPool::getMetrics() const
+{
+    const juce::ScopedLock sl (metricsLock);
+    return metrics;
+}
+
+void ConnectionPool::recordRequest (bool ok, double timeToFirstByteMs, juce::int64 bytes)
+{
+    const juce::ScopedLock sl (metricsLock);
+    ++metrics.requests;
+    if (! ok) ++metrics.failedRequests;
+    metrics.bytesReceived          += bytes;
+    metrics.totalTimeToFirstByteMs += timeToFirstByteMs;
+}
+
+void ConnectionPool::recordConnectionOpened()
+{
+    const juce::ScopedLock sl (metricsLock);
+    ++metrics.connectionsOpened;
+}
+
+juce::String ConnectionPool::Metrics::toString() const
+{
+    return juce::String (requests) + " requests ("
+         + juce::String (failedRequests) + " failed), "
+         + juce::String (connectionsOpened) + " handshakes, "
+         + juce::String (bytesReceived / 1024) + " KB, avg TTFB "
+         + juce::String (getAverageTimeToFirstByteMs(), 1) + " ms";
+}
+
+juce::var ConnectionPool::Metrics::toVar() const
+{
+    auto* obj = new juce::DynamicObject();
+    obj->setProperty ("requests",             requests);
+    obj->setProperty ("failedRequests",       failedRequests);
+    obj->setProperty ("connectionsOpened",    connectionsOpened);
+    obj->setProperty ("bytesReceived",        bytesReceived);
+    obj->setProperty ("avgTimeToFirstByteMs", getAverageTimeToFirstByteMs());
+    return juce::var (obj);
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <functional>
+
+//==============================================================================
+// 444 Radio Plugin — HTTP Connection Pool
+//
+// One process-wide HTTP session shared by every download job and every
+// plugin instance (hold it through juce::SharedResourcePointer).
+//
+// Windows:  WinHTTP session with keep-alive and HTTP/2 enabled — repeated
+//           fetches from the same R2 origin reuse the open TLS connection.
+// Elsewhere: falls back to juce::URL (the OS networking stack pools what
+//           it can; every request is counted as a new connection).
+//==============================================================================
+class ConnectionPool
+{
+    struct Pimpl;
+
+public:
+    ConnectionPool();
+    ~ConnectionPool();
+
+    // Stops a fetch from another thread — including one blocked waiting on
+    // the network: the in-flight request is closed, so the read returns.
+    class Cancellation
+    {
+    public:
+        void cancel();
+        bool isCancelled() const noexcept   { return cancelled.load(); }
+
+    private:
+        friend struct ConnectionPool::Pimpl;
+
+        bool setAbortAction (std::function<void()>);   // false if already cancelled
+        bool clearAbortAction();                        // true if the action never ran
+
+        std::atomic<bool>     cancelled { false };
+        juce::CriticalSection lock;
+        std::function<void()> abortAction;
+    };
+
+    struct Metrics
+    {
+        juce::int64 requests           = 0;
+        juce::int64 failedRequests     = 0;
+        juce::int64 connectionsOpened  = 0;   // TCP/TLS handshakes
+        juce::int64 bytesReceived      = 0;
+        double      totalTimeToFirstByteMs = 0.0;
+
+        double getAverageTimeToFirstByteMs() const
+        {
+            return requests > 0 ? totalTimeToFirstByteMs / (double) requests : 0.0;
+        }
+
+        juce::String toString() const;
+        juce::var    toVar() const;      // for the bridge `metrics` event
+    };
+
+    // Streams `url` into `dest`; stops early once `cancellation` is cancelled
+    bool fetchToFile (const juce::String& url, const juce::File& dest,
+                      Cancellation& cancellation);
+
+    Metrics getMetrics() const;
+
+    static constexpr int kConnectionTimeoutMs = 30000;
+
+private:
+    void recordRequest (bool ok, double timeToFirstByteMs, juce::int64 bytes);
+    void recordConnectionOpened();
+
+    std::unique_ptr<Pimpl> pimpl;
+
+    mutable juce::CriticalSection metricsLock;
+    Metrics metrics;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ConnectionPool)
+};
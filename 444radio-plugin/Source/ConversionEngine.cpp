@@ -0,0 +1,727 @@
+#include "ConversionEngine.h"
+#include "Fingerprint.h"
+#include <condition_variable>
+#include <mutex>
+
+static constexpr int kDecodeBlockSize = 65536;
+
+//==============================================================================
+//  LevelAnalyser — peak / RMS / peaks-overview / fingerprint, fed block by
+//  block while the file is being decoded so analysis never needs a second
+//  decode.
+//==============================================================================
+class LevelAnalyser
+{
+public:
+    LevelAnalyser (const juce::AudioFormatReader& reader)
+        : LevelAnalyser (reader.sampleRate, (int) reader.numChannels, reader.lengthInSamples)
+    {
+    }
+
+    LevelAnalyser (double sampleRate, int numChannels, juce::int64 lengthInSamples)
+        : peaks ((size_t) GenerationPeaks::kResolution, 0),
+          fingerprint (sampleRate, lengthInSamples)
+    {
+        result.sampleRate      = sampleRate;
+        result.numChannels     = numChannels;
+        result.lengthInSamples = lengthInSamples;
+
+        const auto numBuckets = (juce::int64) GenerationPeaks::kResolution;
+        samplesPerBucket = juce::jmax ((juce::int64) 1,
+                                       (lengthInSamples + numBuckets - 1) / numBuckets);
+    }
+
+    void process (const juce::AudioBuffer<float>& block, int numSamples, juce::int64 startSample)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            float level = 0.0f;
+            for (int ch = 0; ch < block.getNumChannels(); ++ch)
+            {
+                auto s = block.getSample (ch, i);
+                level = juce::jmax (level, std::abs (s));
+                sumSquares += (double) s * s;
+            }
+
+            peak = juce::jmax (peak, level);
+
+            auto bucketIndex = juce::jmin ((size_t) ((startSample + i) / samplesPerBucket), peaks.size() - 1);
+            auto& bucket     = peaks[bucketIndex];
+            bucket = juce::jmax (bucket, (juce::uint8) juce::jlimit (0, 255, juce::roundToInt (level * 255.0f)));
+        }
+
+        fingerprint.process (block, numSamples);
+    }
+
+    GenerationAnalysis finish (const juce::File& peaksDest)
+    {
+        auto numValues = (double) result.lengthInSamples * (double) juce::jmax (1, result.numChannels);
+
+        result.peakLevel = peak;
+        result.rmsLevel  = numValues > 0.0 ? (float) std::sqrt (sumSquares / numValues) : 0.0f;
+        fingerprint.finish (result);
+
+        if (! GenerationPeaks::write (peaksDest, peaks))
+            DBG ("444 Radio: could not write peaks — " + peaksDest.getFullPathName());
+
+        return result;
+    }
+
+private:
+    GenerationAnalysis       result;
+    std::vector<juce::uint8> peaks;
+    FingerprintBuilder       fingerprint;
+    juce::int64              samplesPerBucket = 1;
+    double                   sumSquares = 0.0;
+    float                    peak = 0.0f;
+};
+
+//==============================================================================
+//  DecodedBlock — one block of decoded audio on its way to the WAV writer.
+//
+//  Integer sources (WAV/AIFF/FLAC) stay in the reader's 32-bit integer form
+//  all the way to the writer: a float round trip (x 1/0x7fffffff on read,
+//  x 0x7fffffff on write, then truncation to 24/16 bits) turns every loud
+//  positive sample 1 LSB low.  `floats` is a copy for the analyser.
+//==============================================================================
+struct DecodedBlock
+{
+    juce::AudioBuffer<float> floats;
+    std::vector<int>         ints;
+    std::vector<int*>        intChannels;   // null-terminated, into `ints`
+    int                      numSamples = 0;
+    bool                     isInteger  = false;
+
+    bool read (juce::AudioFormatReader& reader, juce::int64 start, int n)
+    {
+        const auto numChannels = (int) reader.numChannels;
+        numSamples = n;
+        isInteger  = ! reader.usesFloatingPointData;
+        floats.setSize (numChannels, n, false, false, true);
+
+        if (! isInteger)
+            return reader.read (&floats, 0, n, start, true, true);
+
+        ints.resize ((size_t) numChannels * (size_t) n);
+        intChannels.assign ((size_t) numChannels + 1, nullptr);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            intChannels[(size_t) ch] = ints.data() + (size_t) ch * (size_t) n;
+
+        if (! reader.read (intChannels.data(), numChannels, start, n, true))
+            return false;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            juce::FloatVectorOperations::convertFixedToFloat (floats.getWritePointer (ch), intChannels[(size_t) ch],
+                                                              1.0f / (float) 0x7fffffff, n);
+        return true;
+    }
+
+    bool write (juce::AudioFormatWriter& writer) const
+    {
+        return isInteger ? writer.write (const_cast<const int**> (intChannels.data()), numSamples)
+                         : writer.writeFromAudioSampleBuffer (floats, 0, numSamples);
+    }
+};
+
+//==============================================================================
+//  SegmentPipeline — decodes fixed-length segments of one source on the
+//  decode pool and hands them to the writer strictly in order.
+//
+//  Workers pull the next undecoded segment from a shared counter, so fast
+//  workers simply take more segments.  At most `slots.size()` segments are
+//  held in memory; a worker waits before running that far ahead of the
+//  writer.  Each worker opens its own reader (readers are not thread-safe).
+//==============================================================================
+class SegmentPipeline
+{
+public:
+    SegmentPipeline (const juce::File& src, juce::int64 totalLength,
+                     juce::int64 segLength, int maxWorkers)
+        : source (src),
+          length (totalLength),
+          segmentLength (segLength),
+          numSegments ((int) ((totalLength + segLength - 1) / segLength)),
+          numWorkers (juce::jlimit (1, numSegments, maxWorkers)),
+          slots ((size_t) (numWorkers + 2))
+    {
+    }
+
+    ~SegmentPipeline()
+    {
+        std::unique_lock<std::mutex> lk (mutex);
+        aborted = true;
+        changed.notify_all();
+        changed.wait (lk, [this] { return runningWorkers == 0; });
+    }
+
+    int getNumSegments() const { return numSegments; }
+    int getNumWorkers() const  { return numWorkers; }
+
+    void start (juce::ThreadPool& decodePool)
+    {
+        {
+            std::lock_guard<std::mutex> lk (mutex);
+            runningWorkers = numWorkers;
+        }
+
+        for (int i = 0; i < numWorkers; ++i)
+            decodePool.addJob ([this] { workerLoop(); });
+    }
+
+    // Blocks until segment `index` is decoded; nullptr if decoding failed
+    const DecodedBlock* waitForSegment (int index)
+    {
+        std::unique_lock<std::mutex> lk (mutex);
+        auto& slot = slots[(size_t) index % slots.size()];
+        changed.wait (lk, [&] { return slot.index == index || runningWorkers == 0; });
+
+        return (slot.index == index && slot.ok) ? &slot.block : nullptr;
+    }
+
+    // Writer is done with segment `index` — its slot can be reused
+    void releaseSegment (int index)
+    {
+        std::lock_guard<std::mutex> lk (mutex);
+        nextToConsume = index + 1;
+        changed.notify_all();
+    }
+
+private:
+    struct Slot
+    {
+        DecodedBlock block;
+        int          index = -1;
+        bool         ok    = false;
+    };
+
+    void workerLoop()
+    {
+        juce::AudioFormatManager fmtMgr;
+        ConversionEngine::registerFormats (fmtMgr);
+        std::unique_ptr<juce::AudioFormatReader> reader (fmtMgr.createReaderFor (source));
+
+        while (reader != nullptr)
+        {
+            int index = 0;
+            {
+                std::unique_lock<std::mutex> lk (mutex);
+                changed.wait (lk, [this]
+                {
+                    return aborted || nextSegment >= numSegments
+                        || nextSegment < nextToConsume + (int) slots.size();
+                });
+
+                if (aborted || nextSegment >= numSegments)
+                    break;
+
+                index = nextSegment++;
+            }
+
+            // The slot's previous segment (index - slots.size()) is already
+            // released, so it can be filled without holding the lock.
+            auto& slot  = slots[(size_t) index % slots.size()];
+            auto  start = (juce::int64) index * segmentLength;
+            auto  n     = (int) juce::jmin (segmentLength, length - start);
+
+            auto ok = slot.block.read (*reader, start, n);
+
+            std::lock_guard<std::mutex> lk (mutex);
+            slot.index = index;
+            slot.ok    = ok;
+            changed.notify_all();
+        }
+
+        std::lock_guard<std::mutex> lk (mutex);
+        --runningWorkers;
+        changed.notify_all();
+    }
+
+    const juce::File  source;
+    const juce::int64 length;
+    const juce::int64 segmentLength;
+    const int         numSegments;
+    const int         numWorkers;
+
+    std::mutex              mutex;
+    std::condition_variable changed;
+    std::vector<Slot>       slots;
+    int                     nextSegment    = 0;
+    int                     nextToConsume  = 0;
+    int                     runningWorkers = 0;
+    bool                    aborted        = false;
+};
+
+// Formats whose readers seek to the exact sample, so independently decoded
+// segments join bit-for-bit
+static bool canDecodeInSegments (const juce::AudioFormatReader& reader)
+{
+    auto name = reader.getFormatName();
+    return name.startsWithIgnoreCase ("WAV")  || name.startsWithIgnoreCase ("AIFF")
+        || name.startsWithIgnoreCase ("FLAC") || name.startsWithIgnoreCase ("Ogg");
+}
+
+//==============================================================================
+ConversionEngine::ConversionEngine()
+    : pool (juce::jmax (1, juce::SystemStats::getNumCpus() - 1)),
+      decodePool (juce::SystemStats::getNumCpus())
+{
+}
+
+ConversionEngine::~ConversionEngine()
+{
+    pool.removeAllJobs (true, 30000);         // import jobs wait on their segment decoders,
+    decodePool.removeAllJobs (true, 30000);   // so drain them first
+}
+
+void ConversionEngine::registerFormats (juce::AudioFormatManager& fmtMgr)
+{
+    fmtMgr.registerBasicFormats();   // WAV, AIFF, FLAC, Ogg Vorbis
+    fmtMgr.registerFormat (new juce::MP3AudioFormat(), false);
+}
+
+juce::StringArray ConversionEngine::getSupportedWireFormats()
+{
+    // "vorbis", not "ogg": Ogg also carries Opus, which JUCE can't decode
+    return { "flac", "vorbis", "mp3", "wav" };
+}
+
+//==============================================================================
+//  Import on the shared pool → callback on the message thread
+//==============================================================================
+void ConversionEngine::importAsync (const juce::File& source, const juce::File& dest,
+                                    bool wantWav, const juce::File& peaksDest,
+                                    std::function<void (Result)> onDone)
+{
+    pool.addJob ([this, source, dest, wantWav, peaksDest, onDone]
+    {
+        auto result = importFile (source, dest, wantWav, peaksDest);
+
+        juce::MessageManager::callAsync ([onDone, result]()
+        {
+            if (onDone) onDone (result);
+        });
+    });
+}
+
+void ConversionEngine::exportRegionAsync (const juce::File& source, juce::Range<juce::int64> sampleRange,
+                                          const juce::File& dest, const juce::File& peaksDest,
+                                          std::function<void (Result)> onDone)
+{
+    pool.addJob ([source, sampleRange, dest, peaksDest, onDone]
+    {
+        auto result = exportRegion (source, sampleRange, dest, peaksDest);
+
+        juce::MessageManager::callAsync ([onDone, result]()
+        {
+            if (onDone) onDone (result);
+        });
+    });
+}
+
+ConversionEngine::Result ConversionEngine::importFile (const juce::File& source,
+                                                       const juce::File& dest,
+                                                       bool wantWav,
+                                                       const juce::File& peaksDest)
+{
+    Result result;
+    result.file = dest;
+
+    // Check if the downloaded data is already WAV
+    bool isAlreadyWav = false;
+    {
+        juce::FileInputStream peek (source);
+        if (peek.openedOk() && peek.getTotalLength() >= 12)
+        {
+            char header[4];
+            peek.read (header, 4);
+            isAlreadyWav = (memcmp (header, "RIFF", 4) == 0);
+        }
+    }
+
+    if (wantWav && ! isAlreadyWav)
+    {
+        // Decode FLAC/Ogg/MP3 → WAV, analysing as we go
+        DBG ("444 Radio: converting to WAV...");
+        if (convertToWav (source, dest, peaksDest, result.analysis))
+        {
+            source.deleteFile();  // remove temp
+            result.ok = true;
+            return result;
+        }
+
+        // Not audio we can decode (or the write failed) — nothing to import
+        DBG ("444 Radio: WAV conversion failed");
+        source.deleteFile();
+        return result;
+    }
+
+    // Already the right format — just rename, as long as it really is audio
+    result.analysis = analyseAudio (source, peaksDest);
+
+    if (result.analysis.sampleRate <= 0.0)
+    {
+        DBG ("444 Radio: downloaded file is not readable audio — " + source.getFullPathName());
+        source.deleteFile();
+        return result;
+    }
+
+    result.ok = source.moveFileTo (dest);
+    if (! result.ok)
+        source.deleteFile();
+
+    return result;
+}
+
+//==============================================================================
+//  Convert any supported audio file to WAV using JUCE AudioFormatManager
+//==============================================================================
+bool ConversionEngine::convertToWav (const juce::File& source,
+                                     const juce::File& dest,
+                                     const juce::File& peaksDest,
+                                     GenerationAnalysis& analysis,
+                                     int maxDecodeThreads,
+                                     int* numDecodersUsed)
+{
+    juce::AudioFormatManager fmtMgr;
+    registerFormats (fmtMgr);
+
+    std::unique_ptr<juce::AudioFormatReader> reader (
+        fmtMgr.createReaderFor (source));
+
+    if (reader == nullptr)
+    {
+        DBG ("444 Radio: could not create reader for " + source.getFullPathName());
+        return false;
+    }
+
+    juce::WavAudioFormat wavFormat;
+    dest.getParentDirectory().createDirectory();
+    std::unique_ptr<juce::FileOutputStream> outStream (
+        dest.createOutputStream());
+
+    if (outStream == nullptr)
+    {
+        DBG ("444 Radio: could not open output for " + dest.getFullPathName());
+        return false;
+    }
+
+    outStream->setPosition (0);   // `dest` may be an empty placeholder reserving the name
+    outStream->truncate();
+
+    // Lossless sources (FLAC/WAV/AIFF) keep their bit depth and go through
+    // as integers (see DecodedBlock); lossy decoders hand us floats, which go
+    // out as 16-bit PCM as before.
+    const int bitDepth = reader->usesFloatingPointData
+                           ? 16
+                           : juce::jlimit (16, 24, (int) reader->bitsPerSample);
+
+    std::unique_ptr<juce::AudioFormatWriter> writer (
+        wavFormat.createWriterFor (outStream.get(),
+                                   reader->sampleRate,
+                                   reader->numChannels,
+                                   bitDepth,
+                                   {}, 0));
+
+    if (writer == nullptr)
+    {
+        DBG ("444 Radio: could not create WAV writer");
+        return false;
+    }
+
+    outStream.release();  // writer now owns the stream
+
+    LevelAnalyser analyser (*reader);
+    bool ok = true;
+
+    const auto startMs       = juce::Time::getMillisecondCounterHiRes();
+    const auto segmentLength = (juce::int64) (reader->sampleRate * kSegmentSeconds);
+    const auto maxWorkers    = maxDecodeThreads > 0 ? juce::jmin (maxDecodeThreads, decodePool.getNumThreads())
+                                                    : decodePool.getNumThreads();
+    int numWorkers = 1;
+
+    if (canDecodeInSegments (*reader) && segmentLength > 0 && maxWorkers > 1
+         && reader->lengthInSamples >= 2 * segmentLength)
+    {
+        // Parallel: segments decode on the decode pool, written here in order
+        SegmentPipeline pipeline (source, reader->lengthInSamples, segmentLength, maxWorkers);
+        pipeline.start (decodePool);
+        numWorkers = pipeline.getNumWorkers();
+
+        for (int i = 0; ok && i < pipeline.getNumSegments(); ++i)
+        {
+            auto* segment = pipeline.waitForSegment (i);
+            ok = segment != nullptr && segment->write (*writer);
+
+            if (ok)
+                analyser.process (segment->floats, segment->numSamples, (juce::int64) i * segmentLength);
+
+            pipeline.releaseSegment (i);
+        }
+    }
+    else
+    {
+        // Serial: block by block on this thread
+        DecodedBlock block;
+
+        for (juce::int64 pos = 0; ok && pos < reader->lengthInSamples;)
+        {
+            auto n = (int) juce::jmin ((juce::int64) kDecodeBlockSize, reader->lengthInSamples - pos);
+
+            ok = block.read (*reader, pos, n) && block.write (*writer);
+
+            analyser.process (block.floats, n, pos);
+            pos += n;
+        }
+    }
+
+    // Benchmark: audio length vs. wall time vs. decoder count
+    DecodeStat stat;
+    stat.format       = reader->getFormatName();
+    stat.audioSeconds = (double) reader->lengthInSamples / reader->sampleRate;
+    stat.elapsedMs    = juce::Time::getMillisecondCounterHiRes() - startMs;
+    stat.threads      = numWorkers;
+
+    DBG ("444 Radio: decoded " + juce::String (stat.audioSeconds, 1) + " s of " + stat.format
+         + " in " + juce::String (stat.elapsedMs, 1) + " ms on " + juce::String (numWorkers)
+         + " thread(s) — " + juce::String (stat.audioSeconds * 1000.0 / juce::jmax (1.0, stat.elapsedMs), 1)
+         + "x realtime");
+
+    if (ok)
+        recordDecode (stat);
+
+    if (numDecodersUsed != nullptr)
+        *numDecodersUsed = numWorkers;
+
+    writer.reset();  // flush & close
+
+    if (ok)
+    {
+        analysis = analyser.finish (peaksDest);
+        DBG ("444 Radio: converted to WAV (" + juce::String (bitDepth) + "-bit) — "
+             + dest.getFullPathName());
+    }
+    else
+    {
+        DBG ("444 Radio: WAV conversion failed");
+        dest.deleteFile();
+    }
+
+    return ok;
+}
+
+//==============================================================================
+//  Decode statistics + benchmark
+//==============================================================================
+juce::var ConversionEngine::DecodeStat::toVar() const
+{
+    auto* obj = new juce::DynamicObject();
+    obj->setProperty ("format",       format);
+    obj->setProperty ("audioSeconds", audioSeconds);
+    obj->setProperty ("elapsedMs",    elapsedMs);
+    obj->setProperty ("threads",      threads);
+    obj->setProperty ("realtime",     audioSeconds * 1000.0 / juce::jmax (1.0, elapsedMs));
+    return juce::var (obj);
+}
+
+void ConversionEngine::recordDecode (DecodeStat stat)
+{
+    const juce::ScopedLock sl (statsLock);
+    decodeStats.push_back (std::move (stat));
+
+    while ((int) decodeStats.size() > kMaxDecodeStats)
+        decodeStats.pop_front();
+}
+
+juce::var ConversionEngine::getDecodeStats() const
+{
+    const juce::ScopedLock sl (statsLock);
+
+    juce::Array<juce::var> stats;
+    for (auto& stat : decodeStats)
+        stats.add (stat.toVar());
+
+    return stats;
+}
+
+void ConversionEngine::benchmarkAsync (const juce::File& source, juce::Array<int> threadCounts,
+                                       std::function<void (juce::var)> onDone)
+{
+    pool.addJob ([this, source, threadCounts, onDone]
+    {
+        auto scratch = juce::File::createTempFile (".wav");
+        auto peaks   = juce::File::createTempFile (".peaks");
+        juce::Array<juce::var> runs;
+
+        for (auto threads : threadCounts)
+        {
+            GenerationAnalysis analysis;
+            auto startMs = juce::Time::getMillisecondCounterHiRes();
+
+            int decoders = 1;
+            if (! convertToWav (source, scratch, peaks, analysis, juce::jmax (1, threads), &decoders))
+                break;
+
+            // Decoders actually used — short files may have fewer segments
+            // than the cap asked for
+            DecodeStat stat;
+            stat.format       = source.getFileExtension().trimCharactersAtStart (".");
+            stat.audioSeconds = analysis.getLengthInSeconds();
+            stat.elapsedMs    = juce::Time::getMillisecondCounterHiRes() - startMs;
+            stat.threads      = decoders;
+            runs.add (stat.toVar());
+        }
+
+        scratch.deleteFile();
+        peaks.deleteFile();
+
+        juce::MessageManager::callAsync ([onDone, result = juce::var (runs)]()
+        {
+            if (onDone) onDone (result);
+        });
+    });
+}
+
+//==============================================================================
+//  Analyse a file that needed no conversion: level stats + peaks sidecar
+//==============================================================================
+GenerationAnalysis ConversionEngine::analyseAudio (const juce::File& audio,
+                                                   const juce::File& peaksDest)
+{
+    juce::AudioFormatManager fmtMgr;
+    registerFormats (fmtMgr);
+
+    std::unique_ptr<juce::AudioFormatReader> reader (fmtMgr.createReaderFor (audio));
+    if (reader == nullptr || reader->lengthInSamples <= 0)
+        return {};
+
+    LevelAnalyser analyser (*reader);
+    juce::AudioBuffer<float> block ((int) reader->numChannels, kDecodeBlockSize);
+
+    for (juce::int64 pos = 0; pos < reader->lengthInSamples;)
+    {
+        auto n = (int) juce::jmin ((juce::int64) kDecodeBlockSize, reader->lengthInSamples - pos);
+        reader->read (&block, 0, n, pos, true, true);
+        analyser.process (block, n, pos);
+        pos += n;
+    }
+
+    return analyser.finish (peaksDest);
+}
+
+//==============================================================================
+//  Region export — random access into the source, fades at the edges
+//==============================================================================
+ConversionEngine::Result ConversionEngine::exportRegion (const juce::File& source,
+                                                         juce::Range<juce::int64> sampleRange,
+                                                         const juce::File& dest,
+                                                         const juce::File& peaksDest)
+{
+    Result result;
+    result.file = dest;
+
+    // WAV: map only the requested section of the file
+    juce::WavAudioFormat wavFormat;
+    std::unique_ptr<juce::AudioFormatReader> reader;
+
+    if (std::unique_ptr<juce::MemoryMappedAudioFormatReader> mapped { wavFormat.createMemoryMappedReader (source) })
+    {
+        sampleRange = sampleRange.getIntersectionWith ({ 0, mapped->lengthInSamples });
+        if (mapped->mapSectionOfFile (sampleRange))
+            reader = std::move (mapped);
+    }
+
+    // Everything else: a normal reader, which seeks straight to the start
+    if (reader == nullptr)
+    {
+        juce::AudioFormatManager fmtMgr;
+        registerFormats (fmtMgr);
+        reader.reset (fmtMgr.createReaderFor (source));
+    }
+
+    if (reader == nullptr)
+    {
+        DBG ("444 Radio: could not create reader for " + source.getFullPathName());
+        return result;
+    }
+
+    sampleRange = sampleRange.getIntersectionWith ({ 0, reader->lengthInSamples });
+    if (sampleRange.isEmpty())
+        return result;
+
+    dest.getParentDirectory().createDirectory();
+    std::unique_ptr<juce::FileOutputStream> outStream (dest.createOutputStream());
+    if (outStream == nullptr)
+    {
+        DBG ("444 Radio: could not open output for " + dest.getFullPathName());
+        return result;
+    }
+
+    outStream->setPosition (0);
+    outStream->truncate();
+
+    const int bitDepth = reader->usesFloatingPointData
+                           ? 16
+                           : juce::jlimit (16, 24, (int) reader->bitsPerSample);
+
+    std::unique_ptr<juce::AudioFormatWriter> writer (
+        wavFormat.createWriterFor (outStream.get(), reader->sampleRate, reader->numChannels,
+                                   bitDepth, {}, 0));
+    if (writer == nullptr)
+        return result;
+
+    outStream.release();  // writer now owns the stream
+
+    const auto length     = sampleRange.getLength();
+    const auto fadeLength = juce::jmin (length / 2,
+                                        (juce::int64) (reader->sampleRate * kRegionFadeMs / 1000.0));
+
+    LevelAnalyser analyser (reader->sampleRate, (int) reader->numChannels, length);
+    juce::AudioBuffer<float> block ((int) reader->numChannels, kDecodeBlockSize);
+    bool ok = true;
+
+    for (juce::int64 pos = 0; ok && pos < length;)
+    {
+        auto n = (int) juce::jmin ((juce::int64) kDecodeBlockSize, length - pos);
+        ok = reader->read (&block, 0, n, sampleRange.getStart() + pos, true, true);
+
+        // Fade in over the first fadeLength samples, out over the last
+        if (ok && fadeLength > 0)
+        {
+            if (pos < fadeLength)
+            {
+                auto num = juce::jmin ((juce::int64) n, fadeLength - pos);
+                block.applyGainRamp (0, (int) num,
+                                     (float) pos / (float) fadeLength,
+                                     (float) (pos + num) / (float) fadeLength);
+            }
+
+            const auto fadeOutStart = length - fadeLength;
+
+            if (pos + n > fadeOutStart)
+            {
+                auto start = juce::jmax ((juce::int64) 0, fadeOutStart - pos);
+                block.applyGainRamp ((int) start, (int) (n - start),
+                                     (float) (length - (pos + start)) / (float) fadeLength,
+                                     (float) (length - (pos + n)) / (float) fadeLength);
+            }
+        }
+
+        ok = ok && writer->writeFromAudioSampleBuffer (block, 0, n);
+        analyser.process (block, n, pos);
+        pos += n;
+    }
+
+    writer.reset();  // flush & close
+
+    if (! ok)
+    {
+        DBG ("444 Radio: region export failed");
+        dest.deleteFile();
+        return result;
+    }
+
+    result.ok       = true;
+    result.analysis = analyser.finish (peaksDest);
+    return result;
+}
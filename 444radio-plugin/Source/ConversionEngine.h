@@ -0,0 +1,106 @@
+#pragma once
+
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_events/juce_events.h>
+#include <deque>
+#include "SessionManifest.h"
+
+//==============================================================================
+// 444 Radio Plugin — Conversion Engine
+//
+// Turns a downloaded file (WAV / MP3 / FLAC / Ogg Vorbis on the wire) into
+// the file the user drags into the DAW, and analyses it in the same pass.
+//
+// Work runs on a thread pool shared by every plugin instance (hold it via
+// juce::SharedResourcePointer), so a stem set decodes on several cores at
+// once and the message thread never blocks on a decode.
+//
+// Long sources in sample-accurate formats (WAV/AIFF/FLAC/Ogg) are also split
+// into fixed-length segments, decoded in parallel on a second pool and
+// written strictly in order — output is bit-identical to a serial decode.
+// Integer sources stay integer in both paths, so neither rounds samples.
+// MP3 seeking is not sample-exact, so MP3 always decodes serially.
+//==============================================================================
+class ConversionEngine
+{
+public:
+    ConversionEngine();
+    ~ConversionEngine();
+
+    struct Result
+    {
+        bool               ok = false;
+        juce::File         file;
+        GenerationAnalysis analysis;
+    };
+
+    // Decodes `source` to WAV at `dest` (or just moves it there when it is
+    // already WAV or `wantWav` is false), writes the peaks sidecar, then
+    // calls `onDone` on the message thread.  A source that isn't readable
+    // audio is deleted and reported with ok = false.
+    void importAsync (const juce::File& source, const juce::File& dest, bool wantWav,
+                      const juce::File& peaksDest, std::function<void (Result)> onDone);
+
+    // Wire formats the bridge may send in the `format` field
+    static juce::StringArray getSupportedWireFormats();
+
+    // `maxDecodeThreads` caps the segment decoders (0 = whole decode pool,
+    // 1 = serial); `numDecodersUsed` receives the count actually used
+    bool convertToWav (const juce::File& source, const juce::File& dest,
+                       const juce::File& peaksDest, GenerationAnalysis& analysis,
+                       int maxDecodeThreads = 0, int* numDecodersUsed = nullptr);
+    static GenerationAnalysis analyseAudio (const juce::File& audio, const juce::File& peaksDest);
+
+    // Writes just `sampleRange` of `source` to a WAV at `dest`, with short
+    // fades at both edges.  WAV sources are memory-mapped so only the region
+    // is touched; compressed sources seek with their reader's frame index.
+    static Result exportRegion (const juce::File& source, juce::Range<juce::int64> sampleRange,
+                                const juce::File& dest, const juce::File& peaksDest);
+
+    // exportRegion on the shared pool → `onDone` on the message thread.  MP3
+    // sources decode from the start up to the region, so never on the UI.
+    void exportRegionAsync (const juce::File& source, juce::Range<juce::int64> sampleRange,
+                            const juce::File& dest, const juce::File& peaksDest,
+                            std::function<void (Result)> onDone);
+
+    static void registerFormats (juce::AudioFormatManager&);
+
+    // Timings of the most recent conversions (any build, for the bridge
+    // `metrics` event): [{ format, audioSeconds, elapsedMs, threads, realtime }]
+    juce::var getDecodeStats() const;
+
+    // Decodes `source` once per entry of `threadCounts` (1 = serial) into a
+    // scratch file and reports each run's timing on the message thread —
+    // the serial vs. segmented speedup for this file's length and format.
+    void benchmarkAsync (const juce::File& source, juce::Array<int> threadCounts,
+                         std::function<void (juce::var)> onDone);
+
+    static constexpr double kRegionFadeMs       = 5.0;
+    static constexpr double kSegmentSeconds     = 5.0;   // parallel decode unit
+
+private:
+    Result importFile (const juce::File& source, const juce::File& dest, bool wantWav,
+                       const juce::File& peaksDest);
+
+    struct DecodeStat
+    {
+        juce::String format;
+        double       audioSeconds = 0.0;
+        double       elapsedMs    = 0.0;
+        int          threads      = 1;
+
+        juce::var toVar() const;
+    };
+
+    void recordDecode (DecodeStat);
+
+    juce::ThreadPool pool;         // one job per imported file
+    juce::ThreadPool decodePool;   // segment decoders for long files
+
+    mutable juce::CriticalSection statsLock;
+    std::deque<DecodeStat>        decodeStats;   // newest last
+
+    static constexpr int kMaxDecodeStats = 64;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ConversionEngine)
+};
@@ -0,0 +1,527 @@
+#include "Fingerprint.h"
+#include "PluginProcessor.h"
+
+#if JUCE_WINDOWS
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+static constexpr char kIndexMagic[4] = { 'R', '4', 'F', 'I' };
+
+// Bands are log-spaced over the range where generations carry energy
+static constexpr double kLowestBandHz  = 60.0;
+static constexpr double kHighestBandHz = 16000.0;
+
+//==============================================================================
+//  FingerprintBuilder
+//==============================================================================
+FingerprintBuilder::FingerprintBuilder (double sampleRate, juce::int64 lengthInSamples)
+    : energies ((size_t) (kNumBands * kNumTimeCells), 0.0)
+{
+    const auto frameSize = fft.getSize();
+
+    window.resize ((size_t) frameSize);
+    juce::dsp::WindowingFunction<float>::fillWindowingTables (window.data(), (size_t) frameSize,
+                                                               juce::dsp::WindowingFunction<float>::hann, false);
+    frame.resize ((size_t) frameSize * 2, 0.0f);   // FFT works in place on 2N floats
+
+    // Bin → band table, so frames at any sample rate land in the same bands
+    const auto rate = sampleRate > 0.0 ? sampleRate : 44100.0;
+    const auto high = juce::jmin (kHighestBandHz, rate * 0.45);
+
+    bandOfBin.resize ((size_t) frameSize / 2 + 1, -1);
+    for (size_t bin = 1; bin < bandOfBin.size(); ++bin)
+    {
+        auto hz = (double) bin * rate / (double) frameSize;
+        if (hz < kLowestBandHz || hz >= high)
+            continue;
+
+        auto band = (int) (kNumBands * std::log (hz / kLowestBandHz) / std::log (high / kLowestBandHz));
+        bandOfBin[bin] = juce::jlimit (0, kNumBands - 1, band);
+    }
+
+    numFrames = juce::jmax ((juce::int64) 1, lengthInSamples / frameSize);
+}
+
+void FingerprintBuilder::process (const juce::AudioBuffer<float>& block, int numSamples)
+{
+    const auto numChannels = block.getNumChannels();
+    const auto gain        = 1.0f / (float) juce::jmax (1, numChannels);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        float mono = 0.0f;
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto s = block.getSample (ch, i);
+            mono += s;
+
+            juce::uint32 bits;
+            std::memcpy (&bits, &s, sizeof (bits));
+            hash = (hash ^ bits) * 1099511628211ull;
+        }
+
+        frame[(size_t) framePos] = mono * gain;
+
+        if (++framePos == fft.getSize())
+            processFrame();
+    }
+}
+
+void FingerprintBuilder::processFrame()
+{
+    const auto frameSize = (size_t) fft.getSize();
+
+    for (size_t i = 0; i < frameSize; ++i)
+        frame[i] *= window[i];
+
+    fft.performFrequencyOnlyForwardTransform (frame.data());
+
+    auto cell = (int) juce::jmin ((juce::int64) kNumTimeCells - 1, frameIndex * kNumTimeCells / numFrames);
+
+    for (size_t bin = 0; bin < bandOfBin.size(); ++bin)
+        if (auto band = bandOfBin[bin]; band >= 0)
+            energies[(size_t) (band * kNumTimeCells + cell)] += (double) frame[bin] * frame[bin];
+
+    std::fill (frame.begin(), frame.end(), 0.0f);
+    framePos = 0;
+    ++frameIndex;
+}
+
+void FingerprintBuilder::finish (GenerationAnalysis& result)
+{
+    result.contentHash = hash;
+    result.fingerprint = {};
+
+    if (frameIndex == 0)
+        return;   // shorter than one frame — no usable fingerprint
+
+    // One bit per cell: louder than this band's median over the file.  Half
+    // the bits of each band are set, independent of overall level.
+    for (int band = 0; band < kNumBands; ++band)
+    {
+        auto first = energies.begin() + band * kNumTimeCells;
+
+        std::vector<double> sorted (first, first + kNumTimeCells);
+        std::nth_element (sorted.begin(), sorted.begin() + kNumTimeCells / 2, sorted.end());
+        auto median = sorted[(size_t) kNumTimeCells / 2];
+
+        for (int cell = 0; cell < kNumTimeCells; ++cell)
+        {
+            if (first[cell] > median)
+            {
+                auto bit = band * kNumTimeCells + cell;
+                result.fingerprint[(size_t) (bit / 64)] |= (juce::uint64) 1 << (bit % 64);
+            }
+        }
+    }
+}
+
+//==============================================================================
+//  FingerprintIndex
+//
+//  On disk: a log of framed records, [uint8 type][compressedInt size][payload]
+//    header   "R4FI" magic, uint8 version            (first record only)
+//    add      int64 content hash, 4 x int64 fingerprint, path
+//    remove   path                                    (tombstone)
+//  Paths are relative to Downloads.  A later add for the same path replaces
+//  the earlier one; unknown record types are skipped.
+//==============================================================================
+FingerprintIndex::FingerprintIndex()
+    : baseDir (RadioPluginProcessor::getDownloadDirectory()),
+      indexFile (baseDir.getChildFile (".fingerprints"))
+{
+    const juce::ScopedLock sl (lock);
+    syncFromDisk();
+    DBG ("444 Radio: fingerprint index — " + juce::String ((int) files.size()) + " files");
+}
+
+int FingerprintIndex::size() const
+{
+    const juce::ScopedLock sl (lock);
+    return (int) files.size();
+}
+
+juce::File FingerprintIndex::findFile (juce::uint64 id) const
+{
+    const juce::ScopedLock sl (lock);
+
+    auto it = byId.find (id);
+    return it != byId.end() ? files[it->second] : juce::File();
+}
+
+juce::File FingerprintIndex::addOrDeduplicate (const juce::File& file, const GenerationAnalysis& analysis)
+{
+    const juce::ScopedLock sl (lock);
+    syncFromDisk();
+
+    if (analysis.contentHash != 0)
+    {
+        if (auto it = byHash.find (analysis.contentHash); it != byHash.end())
+        {
+            auto existing = files[it->second];
+
+            if (! existing.existsAsFile())
+            {
+                appendRemove (existing);
+            }
+            else if (existing == file)
+            {
+                return file;
+            }
+            else if (existing.getFileExtension().equalsIgnoreCase (file.getFileExtension())
+                      && file.hasIdenticalContentTo (existing))
+            {
+                // Same bytes, not just the same 64-bit hash — keep one copy
+                // on disk
+                file.deleteFile();
+
+                if (createHardLink (existing, file))
+                {
+                    // Indexed too, so it still counts once `existing` is deleted
+                    DBG ("444 Radio: duplicate audio, hardlinked to " + existing.getFullPathName());
+                    appendAdd (file, analysis);
+                    return file;
+                }
+
+                DBG ("444 Radio: duplicate audio, reusing " + existing.getFullPathName());
+                return existing;
+            }
+        }
+    }
+
+    appendAdd (file, analysis);
+    return file;
+}
+
+std::vector<FingerprintIndex::Match> FingerprintIndex::findSimilar (const GenerationAnalysis& analysis,
+                                                                     int maxResults)
+{
+    const auto& query = analysis.fingerprint;
+    if (maxResults <= 0 || query == AudioFingerprint {})
+        return {};
+
+    const juce::ScopedLock sl (lock);
+    syncFromDisk();
+
+    const auto startMs = juce::Time::getMillisecondCounterHiRes();
+
+    // Best `maxResults` (distance, index) pairs, kept sorted
+    std::vector<std::pair<int, size_t>> best;
+    best.reserve ((size_t) maxResults + 1);
+
+    for (size_t i = 0; i < fingerprints.size(); ++i)
+    {
+        const auto& fp = fingerprints[i];
+        auto distance = juce::countNumberOfBits (fp[0] ^ query[0]) + juce::countNumberOfBits (fp[1] ^ query[1])
+                      + juce::countNumberOfBits (fp[2] ^ query[2]) + juce::countNumberOfBits (fp[3] ^ query[3]);
+
+        if (distance > kMaxSimilarDistance
+             || ((int) best.size() == maxResults && distance >= best.back().first)
+             || (analysis.contentHash != 0 && hashes[i] == analysis.contentHash))
+            continue;
+
+        best.insert (std::upper_bound (best.begin(), best.end(), std::make_pair (distance, i)),
+                     std::make_pair (distance, i));
+
+        if ((int) best.size() > maxResults)
+            best.pop_back();
+    }
+
+    DBG ("444 Radio: similarity query over " + juce::String ((int) fingerprints.size()) + " files in "
+         + juce::String (juce::Time::getMillisecondCounterHiRes() - startMs, 3) + " ms");
+    juce::ignoreUnused (startMs);
+
+    std::vector<Match> matches;
+    juce::Array<juce::File> missing;
+
+    for (auto& [distance, index] : best)
+    {
+        if (files[index].existsAsFile())
+            matches.push_back ({ ids[index], files[index], 1.0f - (float) distance / 256.0f });
+        else
+            missing.add (files[index]);
+    }
+
+    // Deleted files drop out of the index when a query first finds them
+    for (auto& file : missing)
+        appendRemove (file);
+
+    return matches;
+}
+
+//==============================================================================
+//  Log → memory
+//==============================================================================
+void FingerprintIndex::syncFromDisk()
+{
+    auto fileSize = indexFile.getSize();
+    if (fileSize == readOffset)
+        return;
+
+    if (fileSize < readOffset)
+    {
+        // Replaced behind our back — start over from its beginning
+        clearMemory();
+        readOffset = 0;
+    }
+
+    juce::MemoryBlock tail;
+    {
+        juce::FileInputStream in (indexFile);
+        if (! in.openedOk() || ! in.setPosition (readOffset))
+            return;
+
+        in.readIntoMemoryBlock (tail, (juce::pointer_sized_int) (fileSize - readOffset));
+    }
+
+    juce::MemoryInputStream records (tail, false);
+    juce::int64 consumed = 0;
+
+    while (records.getNumBytesRemaining() >= 2)
+    {
+        auto type        = (juce::uint8) records.readByte();
+        auto payloadSize = records.readCompressedInt();
+
+        // Every record has a payload, so size <= 0 means a partial record
+        // still being appended by another process — pick it up next time
+        if (payloadSize <= 0 || records.getNumBytesRemaining() < payloadSize)
+            break;
+
+        juce::MemoryBlock payloadData;
+        records.readIntoMemoryBlock (payloadData, payloadSize);
+        juce::MemoryInputStream payload (payloadData, false);
+
+        if (readOffset + consumed == 0)
+        {
+            char magic[4] = {};
+            payload.read (magic, sizeof (magic));
+
+            if (type != recordHeader || memcmp (magic, kIndexMagic, sizeof (magic)) != 0
+                 || (juce::uint8) payload.readByte() != kVersion)
+            {
+                // Not ours (or an older layout) — set it aside, never truncate
+                DBG ("444 Radio: fingerprint index unreadable — starting a new one");
+                indexFile.moveFileTo (indexFile.getSiblingFile (".fingerprints.old"));
+                return;
+            }
+        }
+        else if (type == recordAdd)
+        {
+            auto hash = (juce::uint64) payload.readInt64();
+
+            AudioFingerprint fp;
+            for (auto& word : fp)
+                word = (juce::uint64) payload.readInt64();
+
+            applyAdd (payload.readString(), hash, fp);
+        }
+        else if (type == recordRemove)
+        {
+            applyRemove (payload.readString());
+        }
+
+        consumed = records.getPosition();
+    }
+
+    readOffset += consumed;
+}
+
+void FingerprintIndex::applyAdd (const juce::String& path, juce::uint64 hash, const AudioFingerprint& fp)
+{
+    if (path.isEmpty())
+        return;
+
+    auto id = getPathId (path);
+    auto it = byId.find (id);
+    size_t index;
+
+    if (it != byId.end())
+    {
+        // Same path, new content: update in place
+        index = it->second;
+
+        if (auto old = byHash.find (hashes[index]); old != byHash.end() && old->second == index)
+            byHash.erase (old);
+
+        fingerprints[index] = fp;
+        hashes[index]       = hash;
+    }
+    else
+    {
+        index = files.size();
+        fingerprints.push_back (fp);
+        hashes.push_back (hash);
+        files.push_back (baseDir.getChildFile (path));
+        ids.push_back (id);
+        byId.emplace (id, index);
+    }
+
+    if (hash != 0)
+        byHash.emplace (hash, index);   // the first file with this audio stays canonical
+}
+
+void FingerprintIndex::applyRemove (const juce::String& path)
+{
+    if (auto it = byId.find (getPathId (path)); it != byId.end())
+        removeAt (it->second);
+}
+
+void FingerprintIndex::removeAt (size_t index)
+{
+    const auto last = files.size() - 1;
+
+    if (auto it = byHash.find (hashes[index]); it != byHash.end() && it->second == index)
+    {
+        // Another file with the same audio (a hardlinked copy) takes over
+        byHash.erase (it);
+
+        for (size_t i = 0; i < files.size(); ++i)
+        {
+            if (i != index && hashes[i] == hashes[index])
+            {
+                byHash.emplace (hashes[i], i);   // re-pointed below if i is `last`
+                break;
+            }
+        }
+    }
+
+    byId.erase (ids[index]);
+
+    if (index != last)
+    {
+        fingerprints[index] = fingerprints[last];
+        hashes[index]       = hashes[last];
+        files[index]        = files[last];
+        ids[index]          = ids[last];
+
+        if (auto it = byHash.find (hashes[index]); it != byHash.end() && it->second == last)
+            it->second = index;
+
+        byId[ids[index]] = index;
+    }
+
+    fingerprints.pop_back();
+    hashes.pop_back();
+    files.pop_back();
+    ids.pop_back();
+}
+
+void FingerprintIndex::clearMemory()
+{
+    fingerprints.clear();
+    hashes.clear();
+    files.clear();
+    ids.clear();
+    byHash.clear();
+    byId.clear();
+}
+
+//==============================================================================
+//  Memory → log.  Records are only ever appended; each change reaches memory
+//  by reading it back, in the same order every other process sees it.
+//==============================================================================
+void FingerprintIndex::appendAdd (const juce::File& file, const GenerationAnalysis& analysis)
+{
+    juce::MemoryOutputStream payload;
+    payload.writeInt64 ((juce::int64) analysis.contentHash);
+    for (auto word : analysis.fingerprint)
+        payload.writeInt64 ((juce::int64) word);
+    payload.writeString (getStoredPath (file));
+
+    if (appendRecord (recordAdd, payload.getMemoryBlock()))
+        syncFromDisk();
+}
+
+void FingerprintIndex::appendRemove (const juce::File& file)
+{
+    juce::MemoryOutputStream payload;
+    payload.writeString (getStoredPath (file));
+
+    if (appendRecord (recordRemove, payload.getMemoryBlock()))
+        syncFromDisk();
+}
+
+bool FingerprintIndex::appendRecord (RecordType type, const juce::MemoryBlock& payload)
+{
+    // A new file starts with a header.  Two processes racing here both
+    // write one; only the first counts, later headers are skipped.
+    if (indexFile.getSize() == 0)
+    {
+        juce::MemoryOutputStream header;
+        header.write (kIndexMagic, sizeof (kIndexMagic));
+        header.writeByte ((char) kVersion);
+
+        juce::MemoryOutputStream record;
+        record.writeByte ((char) recordHeader);
+        record.writeCompressedInt ((int) header.getDataSize());
+        record.write (header.getData(), header.getDataSize());
+
+        indexFile.getParentDirectory().createDirectory();
+        if (! appendToFile (indexFile, record.getMemoryBlock()))
+            return false;
+    }
+
+    // One write per record, so concurrent appends never interleave
+    juce::MemoryOutputStream record;
+    record.writeByte ((char) type);
+    record.writeCompressedInt ((int) payload.getSize());
+    record.write (payload.getData(), payload.getSize());
+
+    if (appendToFile (indexFile, record.getMemoryBlock()))
+        return true;
+
+    DBG ("444 Radio: could not append to " + indexFile.getFullPathName());
+    return false;
+}
+
+juce::String FingerprintIndex::getStoredPath (const juce::File& file) const
+{
+    return file.isAChildOf (baseDir) ? file.getRelativePathFrom (baseDir)
+                                     : file.getFullPathName();
+}
+
+juce::uint64 FingerprintIndex::getPathId (const juce::String& storedPath)
+{
+    return (juce::uint64) storedPath.hashCode64();
+}
+
+bool FingerprintIndex::appendToFile (const juce::File& file, const juce::MemoryBlock& data)
+{
+    // The OS's append mode positions every write at the current end of file
+    // atomically, so appends from several processes land whole, one after
+    // another (a seek-then-write could overwrite each other).
+#if JUCE_WINDOWS
+    auto handle = CreateFileW (file.getFullPathName().toWideCharPointer(), FILE_APPEND_DATA,
+                               FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                               OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE)
+        return false;
+
+    DWORD written = 0;
+    auto ok = WriteFile (handle, data.getData(), (DWORD) data.getSize(), &written, nullptr) != 0
+               && written == (DWORD) data.getSize();
+    CloseHandle (handle);
+    return ok;
+#else
+    auto fd = ::open (file.getFullPathName().toRawUTF8(), O_WRONLY | O_APPEND | O_CREAT, 0644);
+    if (fd < 0)
+        return false;
+
+    auto written = ::write (fd, data.getData(), data.getSize());
+    ::close (fd);
+    return written == (ssize_t) data.getSize();
+#endif
+}
+
+bool FingerprintIndex::createHardLink (const juce::File& existing, const juce::File& link)
+{
+#if JUCE_WINDOWS
+    return CreateHardLinkW (link.getFullPathName().toWideCharPointer(),
+                            existing.getFullPathName().toWideCharPointer(), nullptr) != 0;
+#else
+    return ::link (existing.getFullPathName().toRawUTF8(), link.getFullPathName().toRawUTF8()) == 0;
+#endif
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+#include <unordered_map>
+#include "SessionManifest.h"
+
+//==============================================================================
+// 444 Radio Plugin — Audio Fingerprints
+//
+// FingerprintBuilder is fed the decoded audio during conversion (alongside
+// the level analysis) and produces two values:
+//
+//   contentHash  hash of the decoded samples — equal only for identical audio
+//   fingerprint  256 bits: a 16-band x 16-cell spectrogram of the whole file,
+//                one bit per cell set when it is louder than its band's
+//                median.  Near-identical regenerations differ in few bits.
+//
+// FingerprintIndex is the library-wide index of every file in the download
+// directory.  It is kept as flat arrays in memory so a similarity query is
+// one linear popcount scan — ~32 bytes per file, well under a millisecond at
+// tens of thousands of files.
+//
+// On disk it is an append-only record log that several processes (two DAWs,
+// a DAW and a plugin scanner) can share: records are written with the OS's
+// atomic append, removals are tombstone records, the file is never
+// rewritten, and every operation first picks up what other processes have
+// appended since.
+//==============================================================================
+class FingerprintBuilder
+{
+public:
+    FingerprintBuilder (double sampleRate, juce::int64 lengthInSamples);
+
+    void process (const juce::AudioBuffer<float>& block, int numSamples);
+    void finish (GenerationAnalysis& result);
+
+    static constexpr int kNumBands     = 16;
+    static constexpr int kNumTimeCells = 16;
+    static constexpr int kFftOrder     = 11;   // 2048-point frames
+
+private:
+    void processFrame();
+
+    juce::dsp::FFT            fft { kFftOrder };
+    std::vector<float>        window, frame;
+    std::vector<int>          bandOfBin;
+    std::vector<double>       energies;        // [band * kNumTimeCells + cell]
+    juce::int64               numFrames = 1;
+    juce::int64               frameIndex = 0;
+    int                       framePos = 0;
+    juce::uint64              hash = 14695981039346656037ull;   // FNV-1a
+};
+
+//==============================================================================
+class FingerprintIndex
+{
+public:
+    FingerprintIndex();
+
+    struct Match
+    {
+        juce::uint64 id = 0;            // opaque: resolve with findFile()
+        juce::File   file;
+        float        similarity = 0.0f; // 1 = identical fingerprint
+    };
+
+    // Records `file`, or — when identical audio is already in the library —
+    // replaces it with a hardlink to the existing file (or, where links are
+    // not possible, deletes it and returns the existing file instead).
+    juce::File addOrDeduplicate (const juce::File& file, const GenerationAnalysis&);
+
+    // Most similar files in the library, best first.  Exact duplicates of
+    // `analysis` itself are skipped.
+    std::vector<Match> findSimilar (const GenerationAnalysis& analysis, int maxResults);
+
+    // File for an id from a Match; nonexistent File if it has left the index
+    juce::File findFile (juce::uint64 id) const;
+
+    int size() const;
+
+    static constexpr int kMaxSimilarDistance = 64;   // of 256 bits; random audio sits near 128
+
+private:
+    enum RecordType : juce::uint8 { recordHeader = 0, recordAdd = 1, recordRemove = 2 };
+
+    void syncFromDisk();
+    void applyAdd (const juce::String& path, juce::uint64 hash, const AudioFingerprint&);
+    void applyRemove (const juce::String& path);
+    void removeAt (size_t index);
+    void clearMemory();
+
+    void appendAdd (const juce::File&, const GenerationAnalysis&);
+    void appendRemove (const juce::File&);
+    bool appendRecord (RecordType, const juce::MemoryBlock& payload);
+
+    juce::String        getStoredPath (const juce::File&) const;
+    static juce::uint64 getPathId (const juce::String& storedPath);
+    static bool         appendToFile (const juce::File&, const juce::MemoryBlock&);
+    static bool         createHardLink (const juce::File& existing, const juce::File& link);
+
+    juce::File                                    baseDir, indexFile;
+    std::vector<AudioFingerprint>                 fingerprints;   // flat: scanned by findSimilar
+    std::vector<juce::uint64>                     hashes;
+    std::vector<juce::File>                       files;
+    std::vector<juce::uint64>                     ids;
+    std::unordered_map<juce::uint64, size_t>      byHash;
+    std::unordered_map<juce::uint64, size_t>      byId;
+    juce::int64                                   readOffset = 0;   // end of the last record applied
+    mutable juce::CriticalSection                 lock;
+
+    static constexpr juce::uint8 kVersion = 2;   // v2: framed records, tombstones
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FingerprintIndex)
+};
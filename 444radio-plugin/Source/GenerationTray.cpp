@@ -0,0 +1,389 @@
+#include "GenerationTray.h"
+#include "PluginProcessor.h"
+
+//==============================================================================
+//  Row — one visible generation.  Handles selection and the OS file drag.
+//==============================================================================
+class GenerationTray::Row final : public juce::Component
+{
+public:
+    explicit Row (GenerationTray& o) : owner (o) {}
+
+    void update (int newRow, bool isSelected)
+    {
+        row      = newRow;
+        selected = isSelected;
+        repaint();
+    }
+
+    void paint (juce::Graphics& g) override
+    {
+        owner.paintRow (g, row, selected, getWidth(), getHeight());
+    }
+
+    void mouseDown (const juce::MouseEvent& e) override
+    {
+        dragStarted = false;
+
+        // Inside the waveform: start a region selection instead of a drag
+        auto wave = getWaveformArea (getWidth(), getHeight());
+        selectingRegion = wave.contains (e.getPosition());
+
+        if (selectingRegion)
+        {
+            regionAnchor = proportionAt (e.x);
+            owner.list.selectRow (row);
+            return;
+        }
+
+        // Clicking inside an existing selection keeps it, so the whole
+        // selection can be dragged; plain click-release narrows it on mouseUp.
+        selectOnMouseUp = selected && ! e.mods.isAnyModifierKeyDown();
+
+        if (! selectOnMouseUp)
+            owner.list.selectRowsBasedOnModifierKeys (row, e.mods, false);
+    }
+
+    void mouseDrag (const juce::MouseEvent& e) override
+    {
+        if (selectingRegion)
+        {
+            if (juce::isPositiveAndBelow (row, (int) owner.entries.size()))
+            {
+                auto p = proportionAt (e.x);
+                owner.setRegion (owner.entries[(size_t) row].cacheKey,
+                                 { juce::jmin (regionAnchor, p), juce::jmax (regionAnchor, p) });
+            }
+            return;
+        }
+
+        if (! dragStarted && e.getDistanceFromDragStart() > 5)
+        {
+            dragStarted = true;
+            owner.dragSelectedFiles (this);
+        }
+    }
+
+    void mouseUp (const juce::MouseEvent& e) override
+    {
+        if (selectingRegion)
+        {
+            owner.regionSelected (row);
+            return;
+        }
+
+        if (selectOnMouseUp && ! dragStarted)
+            owner.list.selectRowsBasedOnModifierKeys (row, e.mods, true);
+    }
+
+    void mouseDoubleClick (const juce::MouseEvent& e) override
+    {
+        // Double-click on the waveform clears the region
+        if (getWaveformArea (getWidth(), getHeight()).contains (e.getPosition()))
+            owner.setRegion (0, {});
+    }
+
+private:
+    double proportionAt (int x) const
+    {
+        auto wave = getWaveformArea (getWidth(), getHeight());
+        return juce::jlimit (0.0, 1.0, (double) (x - wave.getX()) / (double) juce::jmax (1, wave.getWidth()));
+    }
+
+    GenerationTray& owner;
+    int  row             = -1;
+    bool selected        = false;
+    bool dragStarted     = false;
+    bool selectOnMouseUp = false;
+    bool selectingRegion = false;
+    double regionAnchor  = 0.0;
+};
+
+//==============================================================================
+GenerationTray::GenerationTray()
+    : list ("generations", this)
+{
+    list.setRowHeight (kRowHeight);
+    list.setMultipleSelectionEnabled (true);
+    list.setColour (juce::ListBox::backgroundColourId, juce::Colour (0xFF0D0D1A));
+    list.setColour (juce::ListBox::outlineColourId,    juce::Colours::transparentBlack);
+    addChildComponent (list);
+}
+
+GenerationTray::~GenerationTray()
+{
+    peaksLoader.removeAllJobs (true, 2000);
+}
+
+void GenerationTray::setEntries (std::vector<GenerationEntry> newEntries)
+{
+    // Remember the selection by cache key — row indices shift as entries arrive
+    std::unordered_set<juce::uint64> selectedKeys;
+    for (int i = 0; i < list.getNumSelectedRows(); ++i)
+    {
+        auto row = list.getSelectedRow (i);
+        if (juce::isPositiveAndBelow (row, (int) entries.size()))
+            selectedKeys.insert (entries[(size_t) row].cacheKey);
+    }
+
+    entries = std::move (newEntries);
+    std::reverse (entries.begin(), entries.end());   // newest first
+
+    list.updateContent();
+
+    juce::SparseSet<int> rows;
+    for (int i = 0; i < (int) entries.size(); ++i)
+        if (selectedKeys.count (entries[(size_t) i].cacheKey) > 0)
+            rows.addRange ({ i, i + 1 });
+
+    list.setSelectedRows (rows, juce::dontSendNotification);
+    list.setVisible (! entries.empty());
+    repaint();
+}
+
+void GenerationTray::selectEntry (juce::uint64 cacheKey)
+{
+    for (int i = 0; i < (int) entries.size(); ++i)
+    {
+        if (entries[(size_t) i].cacheKey == cacheKey)
+        {
+            list.selectRow (i);
+            return;
+        }
+    }
+}
+
+//==============================================================================
+void GenerationTray::paint (juce::Graphics& g)
+{
+    g.fillAll (juce::Colour (0xFF0D0D1A));
+
+    if (entries.empty())
+    {
+        auto bounds = getLocalBounds().reduced (10, 4);
+        g.setColour (juce::Colour (0xFF1A1A2E));
+        g.fillRoundedRectangle (bounds.toFloat(), 8.0f);
+        g.setColour (juce::Colour (0xFF555570));
+        g.setFont (juce::Font (12.0f));
+        g.drawText ("Generate something to drag into your project",
+                    bounds, juce::Justification::centred);
+    }
+}
+
+void GenerationTray::resized()
+{
+    list.setBounds (getLocalBounds().reduced (0, 4));
+}
+
+juce::Component* GenerationTray::refreshComponentForRow (int row, bool selected,
+                                                         juce::Component* existing)
+{
+    auto* rowComp = dynamic_cast<Row*> (existing);
+    if (rowComp == nullptr)
+    {
+        delete existing;
+        rowComp = new Row (*this);
+    }
+
+    rowComp->update (row, selected);
+    return rowComp;
+}
+
+//==============================================================================
+//  Row painting — everything comes from memory
+//==============================================================================
+void GenerationTray::paintRow (juce::Graphics& g, int row, bool selected, int width, int height)
+{
+    if (! juce::isPositiveAndBelow (row, (int) entries.size()))
+        return;
+
+    const auto& entry = entries[(size_t) row];
+    auto bounds = getRowBounds (width, height);
+
+    g.setColour (selected ? juce::Colour (0xFF7C3AED) : juce::Colour (0xFF1A1A2E));
+    g.fillRoundedRectangle (bounds.toFloat(), 6.0f);
+
+    auto waveArea = getWaveformArea (width, height);
+    auto image    = getWaveformImage (entry, waveArea.getWidth(), waveArea.getHeight());
+    if (image.isValid())
+        g.drawImageAt (image, waveArea.getX(), waveArea.getY());
+
+    if (entry.cacheKey == regionKey && ! region.isEmpty())
+    {
+        auto x1 = waveArea.getX() + juce::roundToInt (region.getStart() * waveArea.getWidth());
+        auto x2 = waveArea.getX() + juce::roundToInt (region.getEnd()   * waveArea.getWidth());
+        g.setColour (juce::Colour (0x5522D3EE));
+        g.fillRect (juce::Rectangle<int> (x1, waveArea.getY(), juce::jmax (1, x2 - x1), waveArea.getHeight()));
+    }
+
+    auto textArea = bounds.withTrimmedRight (bounds.getWidth() / 2).reduced (10, 0);
+    auto seconds  = juce::roundToInt (entry.analysis.getLengthInSeconds());
+
+    g.setColour (juce::Colour (0xFF9999B0));
+    g.setFont (juce::Font (11.0f));
+    g.drawText (juce::String (seconds / 60) + ":" + juce::String (seconds % 60).paddedLeft ('0', 2),
+                textArea.removeFromRight (36), juce::Justification::centredRight);
+
+    g.setColour (juce::Colours::white);
+    g.setFont (juce::Font (13.0f).boldened());
+    g.drawText (entry.title, textArea, juce::Justification::centredLeft, true);
+}
+
+juce::Rectangle<int> GenerationTray::getRowBounds (int width, int height)
+{
+    return juce::Rectangle<int> (width, height).reduced (10, 2);
+}
+
+juce::Rectangle<int> GenerationTray::getWaveformArea (int width, int height)
+{
+    auto bounds = getRowBounds (width, height);
+    return bounds.removeFromRight (bounds.getWidth() / 2).reduced (6, 4);
+}
+
+juce::Image GenerationTray::getWaveformImage (const GenerationEntry& entry, int width, int height)
+{
+    if (width <= 0 || height <= 0)
+        return {};
+
+    auto cachedIt = imageCache.find (entry.cacheKey);
+    if (cachedIt != imageCache.end())
+    {
+        auto& cached = cachedIt->second;
+        cached.lastUsed = ++paintCounter;
+
+        if (cached.image.isValid() && cached.image.getWidth() == width && cached.image.getHeight() == height)
+            return cached.image;
+    }
+
+    auto peaksIt = peaksCache.find (entry.cacheKey);
+    if (peaksIt == peaksCache.end())
+    {
+        requestPeaks (entry);
+        return {};
+    }
+
+    // Render once from the in-memory peaks; the image is reused until resized
+    const auto& peaks = peaksIt->second;
+    juce::Image image (juce::Image::ARGB, width, height, true);
+    {
+        juce::Graphics ig (image);
+        ig.setColour (juce::Colours::white.withAlpha (0.75f));
+
+        const auto mid = (float) height * 0.5f;
+
+        for (int x = 0; x < width; ++x)
+        {
+            float level = 0.0f;
+
+            if (! peaks.empty())
+            {
+                auto first = (size_t) x       * peaks.size() / (size_t) width;
+                auto last  = (size_t) (x + 1) * peaks.size() / (size_t) width;
+                for (auto i = first; i < juce::jmax (last, first + 1) && i < peaks.size(); ++i)
+                    level = juce::jmax (level, (float) peaks[i] / 255.0f);
+            }
+
+            auto half = juce::jmax (0.5f, level * mid);
+            ig.fillRect (juce::Rectangle<float> ((float) x, mid - half, 1.0f, half * 2.0f));
+        }
+    }
+
+    // Only rendered images enter the cache, so rows still waiting for their
+    // peaks never push real images out
+    auto& cached = imageCache[entry.cacheKey];
+    cached.image    = image;
+    cached.lastUsed = ++paintCounter;
+
+    // Evict least-recently-painted images beyond the cap
+    while ((int) imageCache.size() > kMaxCachedImages)
+    {
+        auto oldest = std::min_element (imageCache.begin(), imageCache.end(),
+                                        [] (const auto& a, const auto& b) { return a.second.lastUsed < b.second.lastUsed; });
+        imageCache.erase (oldest);
+    }
+
+    return image;
+}
+
+void GenerationTray::requestPeaks (const GenerationEntry& entry)
+{
+    if (! pendingPeaks.insert (entry.cacheKey).second)
+        return;   // already queued
+
+    auto key       = entry.cacheKey;
+    auto peaksFile = RadioPluginProcessor::getPeaksDirectory().getChildFile (entry.peaksFile);
+    juce::Component::SafePointer<GenerationTray> safeThis (this);
+
+    peaksLoader.addJob ([safeThis, key, peaksFile]
+    {
+        auto peaks = GenerationPeaks::read (peaksFile);
+
+        juce::MessageManager::callAsync ([safeThis, key, peaks = std::move (peaks)]() mutable
+        {
+            if (safeThis == nullptr)
+                return;
+
+            // An empty vector is cached too — draws a flat line, never re-read
+            safeThis->pendingPeaks.erase (key);
+            safeThis->peaksCache[key] = std::move (peaks);
+            safeThis->imageCache.erase (key);
+            safeThis->list.repaint();
+        });
+    });
+}
+
+//==============================================================================
+void GenerationTray::setRegion (juce::uint64 cacheKey, juce::Range<double> newRegion)
+{
+    regionKey  = cacheKey;
+    region     = newRegion;
+    regionFile = juce::File();
+    list.repaint();
+}
+
+void GenerationTray::regionSelected (int row)
+{
+    if (! juce::isPositiveAndBelow (row, (int) entries.size()) || region.isEmpty())
+        return;
+
+    const auto& entry = entries[(size_t) row];
+    if (entry.cacheKey == regionKey && onRegionSelected != nullptr)
+        onRegionSelected (entry, region);
+}
+
+void GenerationTray::setRegionFile (juce::uint64 cacheKey, juce::Range<double> forRegion, const juce::File& file)
+{
+    if (cacheKey == regionKey && forRegion == region)
+        regionFile = file;
+}
+
+void GenerationTray::dragSelectedFiles (juce::Component* source)
+{
+    juce::StringArray files;
+
+    for (int i = 0; i < list.getNumSelectedRows(); ++i)
+    {
+        auto row = list.getSelectedRow (i);
+        if (! juce::isPositiveAndBelow (row, (int) entries.size()))
+            continue;
+
+        const auto& entry = entries[(size_t) row];
+        auto file = entry.file;
+
+        // A row with a region drags its exported slice instead — or nothing
+        // while the slice is still being written
+        if (entry.cacheKey == regionKey && ! region.isEmpty())
+        {
+            file = regionFile;
+
+            if (file == juce::File())
+                DBG ("444 Radio: region still exporting — " + entry.title);
+        }
+
+        if (file.existsAsFile())
+            files.add (file.getFullPathName());
+    }
+
+    if (! files.isEmpty())
+        juce::DragAndDropContainer::performExternalDragDropOfFiles (files, false, source);
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include <unordered_map>
+#include <unordered_set>
+#include "SessionManifest.h"
+
+//==============================================================================
+// 444 Radio Plugin — Generation Tray
+//
+// Scrollable list of every generation in the session (newest first).  Each
+// row shows its waveform and can be dragged into the DAW, alone or as part
+// of a multi-selection (Ctrl/Cmd/Shift-click).  Dragging across a row's
+// waveform selects a region, which is exported in the background; dragging
+// that row then drags just the region.
+//
+// The ListBox only creates components for visible rows.  Peaks sidecars are
+// read on a background thread and waveform images are cached, so the paint
+// path never decodes audio or touches the disk.
+//==============================================================================
+class GenerationTray final : public juce::Component,
+                             private juce::ListBoxModel
+{
+public:
+    GenerationTray();
+    ~GenerationTray() override;
+
+    void setEntries (std::vector<GenerationEntry> newEntries);
+    void selectEntry (juce::uint64 cacheKey);   // select + scroll into view
+    int  getNumEntries() const { return (int) entries.size(); }
+
+    // Called when the user finishes selecting a region, so the slice can be
+    // exported in the background.  `region` is a proportion of the entry's
+    // length (0..1).  Hand the finished file back with setRegionFile().
+    std::function<void (const GenerationEntry&, juce::Range<double> region)> onRegionSelected;
+
+    // The exported slice for a region; ignored if the selection has moved on
+    void setRegionFile (juce::uint64 cacheKey, juce::Range<double> region, const juce::File&);
+
+    void paint (juce::Graphics&) override;
+    void resized() override;
+
+private:
+    class Row;
+
+    // ListBoxModel
+    int  getNumRows() override { return (int) entries.size(); }
+    void paintListBoxItem (int, juce::Graphics&, int, int, bool) override {}
+    juce::Component* refreshComponentForRow (int row, bool selected, juce::Component* existing) override;
+
+    void        paintRow (juce::Graphics&, int row, bool selected, int width, int height);
+    juce::Image getWaveformImage (const GenerationEntry&, int width, int height);
+    void        requestPeaks (const GenerationEntry&);
+    void        dragSelectedFiles (juce::Component* source);
+    void        setRegion (juce::uint64 cacheKey, juce::Range<double>);
+    void        regionSelected (int row);
+
+    static juce::Rectangle<int> getRowBounds (int width, int height);
+    static juce::Rectangle<int> getWaveformArea (int width, int height);
+
+    struct CachedImage
+    {
+        juce::Image  image;
+        juce::uint32 lastUsed = 0;
+    };
+
+    juce::ListBox                                                  list;
+    std::vector<GenerationEntry>                                   entries;
+    std::unordered_map<juce::uint64, std::vector<juce::uint8>>     peaksCache;
+    std::unordered_set<juce::uint64>                               pendingPeaks;
+    std::unordered_map<juce::uint64, CachedImage>                  imageCache;
+    juce::uint32                                                   paintCounter = 0;
+    juce::uint64                                                   regionKey = 0;
+    juce::Range<double>                                            region;
+    juce::File                                                     regionFile;   // exported slice, once ready
+    juce::ThreadPool                                               peaksLoader { 1 };
+
+    static constexpr int kRowHeight        = 34;
+    static constexpr int kMaxCachedImages  = 128;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GenerationTray)
+};
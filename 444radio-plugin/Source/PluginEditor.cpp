@@ -4,6 +4,16 @@
 static const juce::String kPluginUrl  = "https://www.444radio.co.in/plugin";
 static const juce::String kSiteOrigin = "https://444radio.co.in";
 
+// Our own pages: the apex domain and www. (kPluginUrl is on www.)
+static bool isSiteUrl (const juce::String& url)
+{
+    juce::URL parsed (url);
+    auto domain = parsed.getDomain().toLowerCase();
+
+    return parsed.getScheme() == "https"
+        && (domain == "444radio.co.in" || domain == "www.444radio.co.in");
+}
+
 //==============================================================================
 //  Helper: writable WebView2 data folder under %LOCALAPPDATA%\444Radio\WebView2
 //  This avoids permission issues when loaded inside DAWs whose exe lives in
@@ -11,6 +21,8 @@ static const juce::String kSiteOrigin = "https://444radio.co.in";
 //==============================================================================
 #if JUCE_WINDOWS
 #include <windows.h>
+#include <tlhelp32.h>
+#include <psapi.h>
 
 //==============================================================================
 //  Helper: find the directory containing THIS plugin binary (DLL/VST3).
@@ -69,6 +81,52 @@ static bool isWebView2RuntimeAvailable()
 
     return juce::WebBrowserComponent::areOptionsSupported (opts);
 }
+
+//==============================================================================
+//  Memory held by the host and everything it spawned (WebView2 browser,
+//  renderer and GPU processes are descendants of the host process).
+//==============================================================================
+static juce::int64 getProcessTreeWorkingSet()
+{
+    auto snapshot = CreateToolhelp32Snapshot (TH32CS_SNAPPROCESS, 0);
+    if (snapshot == INVALID_HANDLE_VALUE)
+        return 0;
+
+    std::vector<PROCESSENTRY32W> processes;
+    PROCESSENTRY32W pe {};
+    pe.dwSize = sizeof (pe);
+
+    for (auto ok = Process32FirstW (snapshot, &pe); ok; ok = Process32NextW (snapshot, &pe))
+        processes.push_back (pe);
+
+    CloseHandle (snapshot);
+
+    std::vector<DWORD> tree { GetCurrentProcessId() };
+    for (size_t i = 0; i < tree.size(); ++i)
+        for (auto& p : processes)
+            if (p.th32ParentProcessID == tree[i] && p.th32ProcessID != tree[i])
+                tree.push_back (p.th32ProcessID);
+
+    juce::int64 total = 0;
+    for (auto pid : tree)
+    {
+        if (auto process = OpenProcess (PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid))
+        {
+            PROCESS_MEMORY_COUNTERS counters {};
+            if (GetProcessMemoryInfo (process, &counters, sizeof (counters)))
+                total += (juce::int64) counters.WorkingSetSize;
+
+            CloseHandle (process);
+        }
+    }
+
+    return total;
+}
+#else
+static juce::int64 getProcessTreeWorkingSet()
+{
+    return 0;   // WKWebView content processes are XPC services, not children
+}
 #endif
 
 //==============================================================================
@@ -140,81 +198,24 @@ public:
 
     void pageFinishedLoading (const juce::String& url) override
     {
-        juce::ignoreUnused (url);
         DBG ("444 Radio: page loaded — " + url);
+        editor.setCurrentPageUrl (url);
     }
 
 private:
     RadioPluginEditor& editor;
 };
 
-//==============================================================================
-//  Drag Bar
-//==============================================================================
-RadioPluginEditor::DragBar::DragBar() {}
-
-void RadioPluginEditor::DragBar::paint (juce::Graphics& g)
-{
-    g.fillAll (juce::Colour (0xFF0D0D1A));
-    auto bounds = getLocalBounds().reduced (10, 4);
-
-    if (fileReady)
-    {
-        g.setColour (juce::Colour (0xFF7C3AED));
-        g.fillRoundedRectangle (bounds.toFloat(), 8.0f);
-        g.setColour (juce::Colours::white);
-        g.setFont (juce::Font (13.0f).boldened());
-
-        auto label = juce::String ("Drag to DAW: ") + fileName;
-        g.drawText (label, bounds.reduced (10, 0), juce::Justification::centredLeft);
-    }
-    else
-    {
-        g.setColour (juce::Colour (0xFF1A1A2E));
-        g.fillRoundedRectangle (bounds.toFloat(), 8.0f);
-        g.setColour (juce::Colour (0xFF555570));
-        g.setFont (juce::Font (12.0f));
-        g.drawText ("Generate something to drag into your project",
-                    bounds, juce::Justification::centred);
-    }
-}
-
-void RadioPluginEditor::DragBar::mouseDown (const juce::MouseEvent&) {}
-
-void RadioPluginEditor::DragBar::mouseDrag (const juce::MouseEvent& e)
-{
-    if (fileReady && audioFile.existsAsFile() && e.getDistanceFromDragStart() > 5)
-    {
-        juce::DragAndDropContainer::performExternalDragDropOfFiles (
-            { audioFile.getFullPathName() }, false, this);
-    }
-}
-
-void RadioPluginEditor::DragBar::setFile (const juce::String& name,
-                                          const juce::File& file)
-{
-    fileName  = name;
-    audioFile = file;
-    fileReady = true;
-    repaint();
-}
-
-void RadioPluginEditor::DragBar::clearFile()
-{
-    fileReady = false;
-    fileName.clear();
-    audioFile = juce::File();
-    repaint();
-}
-
 //==============================================================================
 //  Audio Downloader (background thread)
 //==============================================================================
 RadioPluginEditor::AudioDownloader::AudioDownloader (
+    ConnectionPool& pool,
     const juce::String& url,
     const juce::File& dest,
     std::function<void (bool, juce::File)> cb)
     : juce::Thread ("444RadioDL"),
+      connectionPool (pool),
       audioUrl (url),
       destination (dest),
       callback (std::move (cb))
@@ -224,37 +225,21 @@ RadioPluginEditor::AudioDownloader::AudioDownloader (
 
 RadioPluginEditor::AudioDownloader::~AudioDownloader()
 {
+    cancel();
     stopThread (15000);
 }
 
-void RadioPluginEditor::AudioDownloader::run()
+void RadioPluginEditor::AudioDownloader::cancel()
 {
-    destination.getParentDirectory().createDirectory();
-
-    auto stream = juce::URL (audioUrl)
-        .createInputStream (
-            juce::URL::InputStreamOptions (juce::URL::ParameterHandling::inAddress)
-                .withConnectionTimeoutMs (30000));
+    signalThreadShouldExit();
+    cancellation.cancel();
+}
 
-    bool ok = false;
+void RadioPluginEditor::AudioDownloader::run()
+{
+    bool ok = connectionPool.fetchToFile (audioUrl, destination, cancellation);
 
-    if (stream != nullptr && ! threadShouldExit())
-    {
-        juce::FileOutputStream out (destination);
-
-        if (out.openedOk())
-        {
-            char buf[8192];
-            while (! threadShouldExit())
-            {
-                auto n = stream->read (buf, sizeof (buf));
-                if (n <= 0) break;
-                out.write (buf, static_cast<size_t> (n));
-            }
-            out.flush();
-            ok = destination.getSize() > 0;
-        }
-    }
+    DBG ("444 Radio: connection pool — " + connectionPool.getMetrics().toString());
 
     auto cb2  = callback;
     auto dest = destination;
@@ -278,14 +263,26 @@ RadioPluginEditor::RadioPluginEditor (RadioPluginProcessor& p)
     setResizeLimits (kMinWidth, kMinHeight, kMaxWidth, kMaxHeight);
 
     // Downloads folder — use LOCALAPPDATA to avoid OneDrive file-locking issues
-    downloadDir = juce::File::getSpecialLocation (juce::File::userApplicationDataDirectory)
-                      .getChildFile ("444Radio")
-                      .getChildFile ("Downloads");
+    downloadDir = RadioPluginProcessor::getDownloadDirectory();
     downloadDir.createDirectory();
 
-    // Drag bar at the bottom
-    dragBar = std::make_unique<DragBar>();
-    addAndMakeVisible (*dragBar);
+    // Generation tray at the bottom — restored from the project manifest
+    tray = std::make_unique<GenerationTray>();
+    tray->onRegionSelected = [this] (const GenerationEntry& entry, juce::Range<double> region)
+    {
+        auto length = (double) entry.analysis.lengthInSamples;
+        auto key    = entry.cacheKey;
+
+        exportRegion (entry, { (juce::int64) (region.getStart() * length),
+                               (juce::int64) (region.getEnd()   * length) },
+                      [this, key, region] (const GenerationEntry& slice)
+                      {
+                          tray->setRegionFile (key, region, slice.file);
+                      });
+    };
+    addAndMakeVisible (*tray);
+    refreshTray();
+    processorRef.manifestReplaced.addChangeListener (this);
 
     // Defer WebView creation by ~200 ms.
     // On Windows the WebView2 runtime can crash if instantiated before
@@ -296,7 +293,14 @@ RadioPluginEditor::RadioPluginEditor (RadioPluginProcessor& p)
 RadioPluginEditor::~RadioPluginEditor()
 {
     stopTimer();
-    downloader.reset();
+    processorRef.manifestReplaced.removeChangeListener (this);
+
+    // Abort every download first, then wait — joining one at a time would
+    // leave the others blocked in their reads
+    for (auto& d : downloads)
+        d->cancel();
+
+    downloads.clear();
     webView.reset();       // destroy WebView before the editor window goes away
 }
 
@@ -305,10 +309,13 @@ RadioPluginEditor::~RadioPluginEditor()
 //==============================================================================
 void RadioPluginEditor::timerCallback()
 {
-    stopTimer();
-
     if (webViewCreated)
+    {
+        updateHibernation();
         return;
+    }
+
+    stopTimer();
 
     // Wait until the editor is actually showing on screen
     if (! isShowing())
@@ -400,18 +407,143 @@ bool RadioPluginEditor::createWebView()
     addAndMakeVisible (*webView);
     resized();
 
-    // Build URL: ?host=juce so the page enables the native bridge
-    juce::String url = kPluginUrl + "?host=juce";
+    // Build URL: ?host=juce so the page enables the native bridge,
+    // &accept= lists the wire formats it may send in the bridge `format` field
+    juce::String url = kPluginUrl + "?host=juce"
+                     + "&accept=" + ConversionEngine::getSupportedWireFormats().joinIntoString (",");
 
     if (processorRef.pluginToken.isNotEmpty())
         url += "&token=" + juce::URL::addEscapeChars (processorRef.pluginToken, false);
 
+    // Page state from before hibernation / editor close rides in the fragment
+    // (never sent to the server); the page restores it on load.
+    if (processorRef.pageSnapshot.isNotEmpty())
+        url += "#restore=" + juce::URL::addEscapeChars (processorRef.pageSnapshot, true);
+
     webView->goToURL (url);
 
     DBG ("444 Radio: WebView navigating to " + url);
+    startTimer (kHibernationCheckMs);
     return true;
 }
 
+//==============================================================================
+//  Hibernation — a hidden editor keeps its page for a grace period, then the
+//  browser is dropped once the page reports it is idle.  The page's state is snapshotted over the bridge and
+//  handed back when the editor is shown again.
+//==============================================================================
+void RadioPluginEditor::updateHibernation()
+{
+    auto now = juce::Time::getMillisecondCounterHiRes();
+
+    if (isShowing())
+    {
+        hiddenSinceMs = 0.0;
+
+        if (hibernating)
+            wakeWebView();
+
+        return;
+    }
+
+    if (hibernating)
+    {
+        if (memoryBeforeHibernate > 0 && now - hibernatedAtMs >= kMemoryReportDelayMs)
+        {
+            hibernateBytesBefore = memoryBeforeHibernate;
+            hibernateBytesAfter  = getProcessTreeWorkingSet();
+            memoryBeforeHibernate = 0;
+
+            DBG ("444 Radio: hibernated WebView — process tree "
+                 + juce::String (hibernateBytesBefore / (1024 * 1024)) + " MB -> "
+                 + juce::String (hibernateBytesAfter / (1024 * 1024)) + " MB");
+        }
+        return;
+    }
+
+    if (hiddenSinceMs <= 0.0)
+    {
+        // Just hidden: ask the page for a fresh snapshot while it's still alive
+        hiddenSinceMs = now;
+        pageIdleWhileHidden = false;
+        sendToPage (juce::JSON::parse (R"({"event":"snapshot_request"})"));
+        return;
+    }
+
+    // Only drop a page that has saved its state and has nothing running —
+    // a generation streams over the page's own fetch and would be lost.
+    // A busy page sends another snapshot when it finishes.
+    if (pageIdleWhileHidden && now - hiddenSinceMs >= kHibernateAfterMs)
+        hibernateWebView();
+}
+
+void RadioPluginEditor::hibernateWebView()
+{
+    if (webView == nullptr)
+        return;
+
+    memoryBeforeHibernate = getProcessTreeWorkingSet();
+    hibernatedAtMs        = juce::Time::getMillisecondCounterHiRes();
+    hibernating           = true;
+
+    webView.reset();
+    currentPageUrl.clear();
+
+    DBG ("444 Radio: WebView hibernated after "
+         + juce::String (kHibernateAfterMs / 1000) + " s hidden");
+}
+
+void RadioPluginEditor::wakeWebView()
+{
+    hibernating    = false;
+    webViewCreated = false;
+    webViewRetries = 0;
+
+    auto startMs = juce::Time::getMillisecondCounterHiRes();
+
+    if (! createWebView())
+    {
+        startTimer (500);   // fall back to the normal retry path
+        return;
+    }
+
+    DBG ("444 Radio: WebView woke in "
+         + juce::String (juce::Time::getMillisecondCounterHiRes() - startMs, 1) + " ms");
+    juce::ignoreUnused (startMs);
+}
+
+//==============================================================================
+//  C++ → page: same-document fragment navigation (#juce=<json>).
+//  JUCE 7 has no evaluateJavascript; the page listens for `hashchange`.
+//
+//  `hashchange` only fires when the fragment differs, so every message
+//  carries a sequence number.  The base URL must be the page's *current*
+//  one — after a client-side (pushState) route change, only the page knows
+//  it and reports it with `page_url`; a stale URL would reload the page.
+//==============================================================================
+void RadioPluginEditor::setCurrentPageUrl (const juce::String& url)
+{
+    if (url.isEmpty())
+        return;
+
+    // Only our own pages listen; on anything else (e.g. the sign-in
+    // provider) messages wait rather than navigate away from it
+    currentPageUrl = isSiteUrl (url) ? url.upToFirstOccurrenceOf ("#", false, false)
+                                     : juce::String();
+}
+
+void RadioPluginEditor::sendToPage (const juce::var& message)
+{
+    if (webView == nullptr || currentPageUrl.isEmpty())
+        return;
+
+    if (auto* obj = message.getDynamicObject())
+        obj->setProperty ("seq", ++pageMessageSeq);
+
+    webView->goToURL (currentPageUrl + "#juce="
+                      + juce::URL::addEscapeChars (juce::JSON::toString (message, true), true));
+}
+
 //==============================================================================
 //  Paint / resize
 //==============================================================================
@@ -461,8 +593,8 @@ void RadioPluginEditor::resized()
 {
     auto area = getLocalBounds();
 
-    if (dragBar != nullptr)
-        dragBar->setBounds (area.removeFromBottom (kDragBarHeight));
+    if (tray != nullptr)
+        tray->setBounds (area.removeFromBottom (kTrayHeight));
 
     if (webView != nullptr)
         webView->setBounds (area);
@@ -517,7 +649,113 @@ void RadioPluginEditor::handleWebMessage (const juce::String& jsonData)
     else if (action == "cover_art")
     {
         auto url = json["url"].toString();
-        if (url.isNotEmpty()) downloadAudio (url, "cover-art");
+        if (url.isNotEmpty()) downloadCoverArt (url);
+    }
+
+    // ── Region export: { url, format, start, end } in seconds ──
+    else if (action == "export_region")
+    {
+        auto format = json["format"].toString();
+        if (format.isEmpty()) format = "wav";
+
+        auto entry = processorRef.manifest.find (
+            GenerationEntry::makeCacheKey (json["url"].toString(), format));
+
+        if (entry.has_value() && entry->analysis.sampleRate > 0.0)
+        {
+            auto rate = entry->analysis.sampleRate;
+            exportRegion (*entry, { (juce::int64) ((double) json["start"] * rate),
+                                    (juce::int64) ((double) json["end"]   * rate) });
+        }
+    }
+
+    // ── Similar generations in the local library: { url, format, limit } ──
+    else if (action == "find_similar")
+    {
+        auto format = json["format"].toString();
+        if (format.isEmpty()) format = "wav";
+
+        findSimilar (json["url"].toString(), format,
+                     json.hasProperty ("limit") ? (int) json["limit"] : 10);
+    }
+
+    // ── Show a similar_results entry in Explorer / Finder: { id } ──
+    else if (action == "reveal_file")
+    {
+        auto id   = (juce::uint64) json["id"].toString().getHexValue64();
+        auto file = processorRef.fingerprintIndex->findFile (id);
+
+        if (file.existsAsFile())
+            file.revealToUser();
+    }
+
+    // ── Download statistics for the page's diagnostics panel ──
+    else if (action == "get_metrics")
+    {
+        auto* reply = new juce::DynamicObject();
+        reply->setProperty ("event",      "metrics");
+        reply->setProperty ("connection", processorRef.connectionPool->getMetrics().toVar());
+        reply->setProperty ("decode",     processorRef.conversionEngine->getDecodeStats());
+
+        // Windows only (0 elsewhere): the last hibernation's process-tree memory
+        auto* hibernation = new juce::DynamicObject();
+        hibernation->setProperty ("beforeBytes", hibernateBytesBefore);
+        hibernation->setProperty ("afterBytes",  hibernateBytesAfter);
+        reply->setProperty ("hibernation", juce::var (hibernation));
+        sendToPage (juce::var (reply));
+    }
+
+    // ── Decode benchmark on an imported generation: { url, format, threads: [1, 2, 4] } ──
+    else if (action == "benchmark_decode")
+    {
+        auto url    = json["url"].toString();
+        auto format = json["format"].toString();
+        if (format.isEmpty()) format = "wav";
+
+        juce::Array<int> threadCounts;
+        if (auto* counts = json["threads"].getArray())
+            for (auto& n : *counts)
+                threadCounts.add (juce::jmax (1, (int) n));
+
+        // Default: serial, then doubling up to every core
+        if (threadCounts.isEmpty())
+            for (int n = 1; n <= juce::SystemStats::getNumCpus(); n *= 2)
+                threadCounts.add (n);
+
+        if (auto entry = processorRef.manifest.find (GenerationEntry::makeCacheKey (url, format)))
+        {
+            juce::Component::SafePointer<RadioPluginEditor> safeThis (this);
+
+            processorRef.conversionEngine->benchmarkAsync (entry->file, threadCounts,
+                [safeThis, url] (juce::var runs)
+                {
+                    if (safeThis == nullptr)
+                        return;
+
+                    auto* reply = new juce::DynamicObject();
+                    reply->setProperty ("event", "benchmark_results");
+                    reply->setProperty ("url",   url);
+                    reply->setProperty ("runs",  runs);
+                    safeThis->sendToPage (juce::var (reply));
+                });
+        }
+    }
+
+    // ── Page state snapshot (for hibernation / editor reopen) ──
+    else if (action == "state_snapshot")
+    {
+        processorRef.pageSnapshot = juce::JSON::toString (json["state"], true);
+        setCurrentPageUrl (json["url"].toString());
+
+        // The latest snapshot decides: idle → may hibernate, busy → may not
+        if (hiddenSinceMs > 0.0)
+            pageIdleWhileHidden = (bool) json["idle"];
+    }
+
+    // ── Client-side route change: keeps C++ → page messages on the current URL ──
+    else if (action == "page_url")
+    {
+        setCurrentPageUrl (json["url"].toString());
     }
 
     // ── Auth: persist token in DAW project state ──
@@ -530,68 +768,167 @@ void RadioPluginEditor::handleWebMessage (const juce::String& jsonData)
 }
 
 //==============================================================================
-//  Audio download → drag bar
+//  Tray mirrors the project manifest (every generation in the session)
 //==============================================================================
+void RadioPluginEditor::refreshTray()
+{
+    if (tray != nullptr)
+        tray->setEntries (processorRef.manifest.getEntries());
+}
+
+void RadioPluginEditor::changeListenerCallback (juce::ChangeBroadcaster*)
+{
+    refreshTray();
+}
+
 //==============================================================================
-//  Convert any audio file to WAV using JUCE AudioFormatManager
+//  Region export → new slice in the manifest + tray, written on the shared
+//  pool.  `onReady` runs (on the message thread) with the slice's entry;
+//  the page is told about every finished slice.
 //==============================================================================
-bool RadioPluginEditor::convertToWav (const juce::File& source,
-                                      const juce::File& dest)
+void RadioPluginEditor::exportRegion (const GenerationEntry& source,
+                                      juce::Range<juce::int64> sampleRange,
+                                      std::function<void (const GenerationEntry&)> onReady)
 {
-    juce::AudioFormatManager fmtMgr;
-    fmtMgr.registerBasicFormats();
-    fmtMgr.registerFormat (new juce::MP3AudioFormat(), false);
+    if (sampleRange.isEmpty() || ! source.file.existsAsFile())
+        return;
 
-    std::unique_ptr<juce::AudioFormatReader> reader (
-        fmtMgr.createReaderFor (source));
+    // The same slice of the same source is exported once
+    auto sliceUrl = source.sourceUrl + "#samples=" + juce::String (sampleRange.getStart())
+                                     + "," + juce::String (sampleRange.getEnd());
+    auto cacheKey = GenerationEntry::makeCacheKey (sliceUrl, "wav");
 
-    if (reader == nullptr)
+    if (auto cached = processorRef.manifest.find (cacheKey))
     {
-        DBG ("444 Radio: could not create reader for " + source.getFullPathName());
-        return false;
+        if (cached->file.existsAsFile())
+        {
+            regionExported (*cached, source.sourceUrl);
+            if (onReady) onReady (*cached);
+            return;
+        }
     }
 
-    juce::WavAudioFormat wavFormat;
-    dest.getParentDirectory().createDirectory();
-    std::unique_ptr<juce::FileOutputStream> outStream (
-        dest.createOutputStream());
+    if (! inFlight.insert (cacheKey).second)
+        return;   // already being written; that job reports it
 
-    if (outStream == nullptr)
-    {
-        DBG ("444 Radio: could not open output for " + dest.getFullPathName());
-        return false;
-    }
+    auto rate  = juce::jmax (1.0, source.analysis.sampleRate);
+    auto title = source.title + " [" + juce::String ((double) sampleRange.getStart() / rate, 2)
+                              + "-"  + juce::String ((double) sampleRange.getEnd()   / rate, 2) + "s]";
 
-    std::unique_ptr<juce::AudioFormatWriter> writer (
-        wavFormat.createWriterFor (outStream.get(),
-                                   reader->sampleRate,
-                                   reader->numChannels,
-                                   16, // 16-bit PCM
-                                   {}, 0));
+    auto startMs   = juce::Time::getMillisecondCounterHiRes();
+    auto dest      = downloadDir.getChildFile (title.replaceCharacters ("\\/:*?\"<>|", "_________") + ".wav")
+                               .getNonexistentSibling();
+    auto peaksName = juce::String::toHexString ((juce::int64) cacheKey) + ".peaks";
+    dest.create();   // claim the name before the pool writes it
 
-    if (writer == nullptr)
-    {
-        DBG ("444 Radio: could not create WAV writer");
-        return false;
-    }
+    juce::Component::SafePointer<RadioPluginEditor> safeThis (this);
+
+    processorRef.conversionEngine->exportRegionAsync (
+        source.file, sampleRange, dest,
+        RadioPluginProcessor::getPeaksDirectory().getChildFile (peaksName),
+        [safeThis, cacheKey, title, sliceUrl, sourceUrl = source.sourceUrl, dest, peaksName, startMs, onReady]
+        (ConversionEngine::Result result)
+        {
+            if (! result.ok && dest.getSize() == 0)
+                dest.deleteFile();
 
-    outStream.release();  // writer now owns the stream
+            if (safeThis == nullptr)
+                return;
 
-    bool ok = writer->writeFromAudioReader (*reader, 0, reader->lengthInSamples);
-    writer.reset();  // flush & close
+            safeThis->inFlight.erase (cacheKey);
 
-    if (ok)
-        DBG ("444 Radio: converted to WAV — " + dest.getFullPathName());
-    else
-        DBG ("444 Radio: WAV conversion failed");
+            if (! result.ok)
+                return;
+
+            DBG ("444 Radio: exported region in "
+                 + juce::String (juce::Time::getMillisecondCounterHiRes() - startMs, 1) + " ms — "
+                 + dest.getFullPathName());
+            juce::ignoreUnused (startMs);
+
+            GenerationEntry entry;
+            entry.cacheKey   = cacheKey;
+            entry.title      = title;
+            entry.sourceUrl  = sliceUrl;
+            entry.format     = "wav";
+            entry.file       = result.file;
+            entry.peaksFile  = peaksName;
+            entry.importedAt = juce::Time::currentTimeMillis();
+            entry.analysis   = result.analysis;
+            entry.file       = safeThis->processorRef.addGeneration (entry, false);   // slices take no key
+
+            safeThis->refreshTray();
+            safeThis->regionExported (entry, sourceUrl);
+            if (onReady) onReady (entry);
+        });
+}
 
-    return ok;
+void RadioPluginEditor::regionExported (const GenerationEntry& slice, const juce::String& sourceUrl)
+{
+    auto* reply = new juce::DynamicObject();
+    reply->setProperty ("event",     "region_exported");
+    reply->setProperty ("sourceUrl", sourceUrl);
+    reply->setProperty ("url",       slice.sourceUrl);   // with format "wav", names the slice over the bridge
+    reply->setProperty ("title",     slice.title);
+    reply->setProperty ("duration",  slice.analysis.getLengthInSeconds());
+    sendToPage (juce::var (reply));
 }
 
+//==============================================================================
+//  Library similarity query → page ({ "event": "similar_results", ... })
+//==============================================================================
+void RadioPluginEditor::findSimilar (const juce::String& url, const juce::String& format, int limit)
+{
+    juce::Array<juce::var> results;
+
+    if (auto entry = processorRef.manifest.find (GenerationEntry::makeCacheKey (url, format)))
+    {
+        for (auto& match : processorRef.fingerprintIndex->findSimilar (entry->analysis, juce::jlimit (1, 100, limit)))
+        {
+            auto* obj = new juce::DynamicObject();
+            obj->setProperty ("id",         juce::String::toHexString ((juce::int64) match.id));
+            obj->setProperty ("name",       match.file.getFileNameWithoutExtension());
+            obj->setProperty ("similarity", match.similarity);
+            results.add (juce::var (obj));
+        }
+    }
+
+    auto* reply = new juce::DynamicObject();
+    reply->setProperty ("event",   "similar_results");
+    reply->setProperty ("url",     url);
+    reply->setProperty ("results", results);
+    sendToPage (juce::var (reply));
+}
+
+//==============================================================================
+//  Audio download → conversion → tray
+//==============================================================================
 void RadioPluginEditor::downloadAudio (const juce::String& url,
                                        const juce::String& title,
                                        const juce::String& format)
 {
+    // Already imported into this project → reuse the file, skip the network
+    auto cacheKey = GenerationEntry::makeCacheKey (url, format);
+
+    if (auto cached = processorRef.manifest.find (cacheKey))
+    {
+        if (cached->file.existsAsFile())
+        {
+            DBG ("444 Radio: manifest hit — " + cached->file.getFullPathName());
+            if (tray != nullptr)
+                tray->selectEntry (cacheKey);
+            return;
+        }
+    }
+
+    // Same URL + format already downloading → that job selects it when done
+    if (! inFlight.insert (cacheKey).second)
+    {
+        DBG ("444 Radio: already downloading " + url);
+        if (tray != nullptr)
+            tray->selectEntry (cacheKey);
+        return;
+    }
+
     // Determine desired extension based on format
     auto desiredExt = format.equalsIgnoreCase ("mp3") ? juce::String (".mp3")
                                                       : juce::String (".wav");
@@ -600,8 +937,11 @@ void RadioPluginEditor::downloadAudio (const juce::String& url,
                          .trimCharactersAtEnd (" ._");
     if (safeName.isEmpty()) safeName = "444radio-generation";
 
-    // Temp file for raw download (we may need to convert)
-    auto tempFile = downloadDir.getChildFile (".444radio-temp-download");
+    // Temp file for raw download (we may need to convert) — reserved now, so
+    // another instance fetching the same URL gets its own
+    auto tempFile = downloadDir.getChildFile (".444radio-temp-" + juce::String::toHexString ((juce::int64) cacheKey))
+                               .getNonexistentSibling (false);
+    tempFile.create();
     auto destFile = downloadDir.getChildFile (safeName + desiredExt);
 
     int counter = 1;
@@ -609,67 +949,101 @@ void RadioPluginEditor::downloadAudio (const juce::String& url,
         destFile = downloadDir.getChildFile (
             safeName + " (" + juce::String (counter++) + ")" + desiredExt);
 
+    // Claim the name now — the file itself is only written later on the
+    // decode pool, and imports with the same title must not share it
+    destFile.create();
+
     DBG ("444 Radio: downloading " + url);
     DBG ("           format=" + format + "  -> " + destFile.getFullPathName());
 
-    downloader.reset();   // cancel any in-progress download
-
     auto displayName = safeName;
-    auto wantWav = format.equalsIgnoreCase ("wav");
+    auto wantWav     = ! format.equalsIgnoreCase ("mp3");   // wav / flac / vorbis → WAV
+    auto peaksName   = juce::String::toHexString ((juce::int64) cacheKey) + ".peaks";
+    juce::Component::SafePointer<RadioPluginEditor> safeThis (this);
 
-    downloader = std::make_unique<AudioDownloader> (url, tempFile,
-        [this, displayName, destFile, tempFile, wantWav] (bool success, juce::File downloaded)
+    startDownload (url, tempFile,
+        [safeThis, displayName, destFile, tempFile, wantWav, cacheKey, url, format, peaksName]
+        (bool success, juce::File downloaded)
         {
-            if (! success)
+            if (safeThis == nullptr || ! success)
             {
-                DBG ("444 Radio: download failed");
+                DBG ("444 Radio: download " + juce::String (success ? "abandoned" : "failed"));
                 tempFile.deleteFile();
-                if (dragBar != nullptr)
-                    dragBar->clearFile();
+                destFile.deleteFile();   // release the reserved (still empty) name
+
+                if (safeThis != nullptr)
+                    safeThis->inFlight.erase (cacheKey);
                 return;
             }
 
             DBG ("444 Radio: download complete — " + downloaded.getFullPathName()
                  + " (" + juce::String (downloaded.getSize() / 1024) + " KB)");
 
-            // Check if the downloaded data is already WAV
-            bool isAlreadyWav = false;
-            {
-                juce::FileInputStream peek (downloaded);
-                if (peek.openedOk() && peek.getTotalLength() >= 12)
+            // Decode + analyse on the shared pool, not the message thread.
+            // The processor records the result, so an editor closed in the
+            // meantime doesn't orphan the file.
+            GenerationEntry entry;
+            entry.cacheKey   = cacheKey;
+            entry.title      = displayName;
+            entry.sourceUrl  = url;
+            entry.format     = format;
+            entry.peaksFile  = peaksName;
+            entry.importedAt = juce::Time::currentTimeMillis();
+
+            safeThis->processorRef.importGeneration (downloaded, destFile, wantWav, entry,
+                [safeThis, cacheKey] (bool ok)
                 {
-                    char header[4];
-                    peek.read (header, 4);
-                    isAlreadyWav = (memcmp (header, "RIFF", 4) == 0);
-                }
-            }
+                    if (safeThis == nullptr)
+                        return;
 
-            juce::File finalFile = destFile;
+                    safeThis->inFlight.erase (cacheKey);
 
-            if (wantWav && ! isAlreadyWav)
-            {
-                // Convert MP3/OGG/whatever → WAV
-                DBG ("444 Radio: converting to WAV...");
-                if (convertToWav (downloaded, destFile))
-                {
-                    downloaded.deleteFile();  // remove temp
-                    finalFile = destFile;
-                }
-                else
-                {
-                    DBG ("444 Radio: WAV conversion failed — keeping original");
-                    downloaded.moveFileTo (destFile);
-                    finalFile = destFile;
-                }
-            }
-            else
-            {
-                // Already the right format — just rename
-                downloaded.moveFileTo (destFile);
-                finalFile = destFile;
-            }
+                    if (! ok)
+                        return;
+
+                    safeThis->refreshTray();
 
-            if (dragBar != nullptr)
-                dragBar->setFile (displayName, finalFile);
+                    if (safeThis->tray != nullptr)
+                        safeThis->tray->selectEntry (cacheKey);
+                });
         });
 }
+
+//==============================================================================
+//  Cover art — an image, so it skips the audio pipeline entirely: saved next
+//  to the downloads, never added to the manifest, tray, sampler or index
+//==============================================================================
+void RadioPluginEditor::downloadCoverArt (const juce::String& url)
+{
+    auto ext = juce::URL (url).getFileName().fromLastOccurrenceOf (".", true, false).toLowerCase();
+    if (! juce::StringArray { ".jpg", ".jpeg", ".png", ".webp" }.contains (ext))
+        ext = ".jpg";
+
+    auto dest = downloadDir.getChildFile ("cover-art" + ext).getNonexistentSibling();
+    dest.create();
+
+    startDownload (url, dest, [dest] (bool success, juce::File)
+    {
+        if (success)
+        {
+            DBG ("444 Radio: cover art saved — " + dest.getFullPathName());
+        }
+        else
+        {
+            DBG ("444 Radio: cover art download failed");
+            dest.deleteFile();
+        }
+    });
+}
+
+void RadioPluginEditor::startDownload (const juce::String& url, const juce::File& dest,
+                                       std::function<void (bool, juce::File)> onDone)
+{
+    // Drop finished jobs; stems and repeated imports download side by side
+    downloads.erase (std::remove_if (downloads.begin(), downloads.end(),
+                                     [] (const std::unique_ptr<AudioDownloader>& d) { return ! d->isThreadRunning(); }),
+                     downloads.end());
+
+    downloads.push_back (std::make_unique<AudioDownloader> (*processorRef.connectionPool, url, dest,
+                                                            std::move (onDone)));
+}
@@ -2,20 +2,23 @@
 
 #include <juce_gui_extra/juce_gui_extra.h>
 #include <juce_audio_utils/juce_audio_utils.h>
+#include <unordered_set>
 #include "PluginProcessor.h"
+#include "GenerationTray.h"
 
 //==============================================================================
 // 444 Radio Plugin — Editor
 //
 // Layout:  [  WebView (loads 444radio.co.in/plugin)  ]
-//          [  Drag Bar (drag generated audio to DAW)  ]
+//          [  Generation tray (drag generations to DAW)  ]
 //
 // Bridge:  JS → C++ via juce-bridge:// URL scheme interception
 //          C++ downloads audio → enables OS-level file drag to Ableton
 //==============================================================================
 class RadioPluginEditor final : public juce::AudioProcessorEditor,
                                 public juce::DragAndDropContainer,
-                                private juce::Timer
+                                private juce::Timer,
+                                private juce::ChangeListener
 {
 public:
     explicit RadioPluginEditor (RadioPluginProcessor&);
@@ -25,39 +28,38 @@ public:
     void resized() override;
 
 private:
-    // Timer: deferred WebView creation (WebView2 crashes if created too early)
+    // Timer: deferred WebView creation (WebView2 crashes if created too early),
+    // then hibernation checks once the WebView exists
     void timerCallback() override;
     bool createWebView();   // returns true on success
 
-    // ─── Drag bar: user drags generated file into DAW timeline ───
-    class DragBar final : public juce::Component
-    {
-    public:
-        explicit DragBar();
-        void paint (juce::Graphics&) override;
-        void mouseDown (const juce::MouseEvent&) override;
-        void mouseDrag (const juce::MouseEvent&) override;
-        void setFile (const juce::String& name, const juce::File& file);
-        void clearFile();
-        bool hasFile() const { return fileReady; }
+    // Project state reloaded by the host → tray shows the new manifest
+    void changeListenerCallback (juce::ChangeBroadcaster*) override;
 
-    private:
-        juce::String fileName;
-        juce::File   audioFile;
-        bool         fileReady = false;
-    };
+    // ─── Hibernation: drop the browser while the editor stays hidden ───
+    void updateHibernation();
+    void hibernateWebView();
+    void wakeWebView();
+    void sendToPage (const juce::var& message);
+    void setCurrentPageUrl (const juce::String& url);   // fragment stripped
 
     // ─── Background audio downloader ───
     class AudioDownloader final : public juce::Thread
     {
     public:
-        AudioDownloader (const juce::String& url,
+        AudioDownloader (ConnectionPool& pool,
+                         const juce::String& url,
                          const juce::File& dest,
                          std::function<void (bool, juce::File)> cb);
         ~AudioDownloader() override;
         void run() override;
 
+        // Asks the thread to stop and aborts its request; doesn't wait
+        void cancel();
+
     private:
+        ConnectionPool& connectionPool;
+        ConnectionPool::Cancellation cancellation;
         juce::String audioUrl;
         juce::File   destination;
         std::function<void (bool, juce::File)> callback;
@@ -67,7 +69,14 @@ private:
     void handleWebMessage (const juce::String& jsonData);
     void downloadAudio (const juce::String& url, const juce::String& title,
                         const juce::String& format = "wav");
-    static bool convertToWav (const juce::File& source, const juce::File& dest);
+    void downloadCoverArt (const juce::String& url);
+    void startDownload (const juce::String& url, const juce::File& dest,
+                        std::function<void (bool, juce::File)> onDone);
+    void refreshTray();
+    void exportRegion (const GenerationEntry&, juce::Range<juce::int64> sampleRange,
+                       std::function<void (const GenerationEntry&)> onReady = nullptr);
+    void regionExported (const GenerationEntry& slice, const juce::String& sourceUrl);
+    void findSimilar (const juce::String& url, const juce::String& format, int limit);
 
     // Allow the file-local BridgeWebView to call handleWebMessage
     friend class BridgeWebView;
@@ -75,13 +84,26 @@ private:
     // ─── Members ───
     RadioPluginProcessor&                      processorRef;
     std::unique_ptr<juce::WebBrowserComponent> webView;
-    std::unique_ptr<DragBar>                   dragBar;
-    std::unique_ptr<AudioDownloader>           downloader;
+    std::unique_ptr<GenerationTray>            tray;
+    std::vector<std::unique_ptr<AudioDownloader>> downloads;   // in flight concurrently
+    std::unordered_set<juce::uint64>           inFlight;    // cache keys being downloaded
     juce::File                                 downloadDir;
+    juce::String                               currentPageUrl;
+    int                                        pageMessageSeq = 0;   // makes every #juce= fragment unique
     bool                                       webViewCreated = false;
+    bool                                       hibernating = false;
+    bool                                       pageIdleWhileHidden = false;   // idle snapshot since hidden
+    double                                     hiddenSinceMs = 0.0;
+    double                                     hibernatedAtMs = 0.0;
+    juce::int64                                memoryBeforeHibernate = 0;
+    juce::int64                                hibernateBytesBefore = 0;   // last hibernation, for `metrics`
+    juce::int64                                hibernateBytesAfter = 0;
     bool                                       showingWebView2Prompt = false;
     int                                        webViewRetries = 0;
     static constexpr int kMaxWebViewRetries = 20;
+    static constexpr int kHibernationCheckMs = 1000;
+    static constexpr int kHibernateAfterMs   = 30000;   // grace period while hidden
+    static constexpr int kMemoryReportDelayMs = 5000;   // let browser processes exit
 
     static constexpr int kWidth         = 480;
     static constexpr int kHeight        = 740;
@@ -89,7 +111,7 @@ private:
     static constexpr int kMinHeight     = 500;
     static constexpr int kMaxWidth      = 1200;
     static constexpr int kMaxHeight     = 1200;
-    static constexpr int kDragBarHeight = 40;
+    static constexpr int kTrayHeight    = 150;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RadioPluginEditor)
 };
@@ -4,20 +4,90 @@
 //==============================================================================
 RadioPluginProcessor::RadioPluginProcessor()
     : AudioProcessor (BusesProperties()
-          .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
-          .withOutput ("Output", juce::AudioChannelSet::stereo(), true))
+                     #if ! JucePlugin_IsSynth
+                      .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
+                     #endif
+                      .withOutput ("Output", juce::AudioChannelSet::stereo(), true))
 {
 }
 
 RadioPluginProcessor::~RadioPluginProcessor() {}
 
-void RadioPluginProcessor::prepareToPlay (double, int) {}
+void RadioPluginProcessor::prepareToPlay (double sampleRate, int)
+{
+   #if JucePlugin_IsSynth
+    sampler.prepare (sampleRate);
+   #else
+    juce::ignoreUnused (sampleRate);
+   #endif
+}
+
 void RadioPluginProcessor::releaseResources() {}
 
-void RadioPluginProcessor::processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&)
+void RadioPluginProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi)
 {
+   #if JucePlugin_IsSynth
+    // Sampler: generations on keys, rendered from RAM
+    sampler.render (buffer, midi);
+   #else
     // Pass-through — this is a utility plugin, not an audio effect.
     // Audio flows in and out unchanged.
+    juce::ignoreUnused (buffer, midi);
+   #endif
+}
+
+juce::File RadioPluginProcessor::addGeneration (const GenerationEntry& entry, bool mapToSamplerKey)
+{
+    auto recorded = entry;
+    recorded.file     = fingerprintIndex->addOrDeduplicate (entry.file, entry.analysis);
+    recorded.midiNote = -1;
+
+    // Keys are assigned in both builds, so a project moved to the sampler
+    // later keeps the same layout
+    if (mapToSamplerKey)
+    {
+        auto replaced = manifest.find (entry.cacheKey);
+        recorded.midiNote = replaced.has_value() && replaced->midiNote >= 0
+                              ? replaced->midiNote
+                              : SamplerEngine::findFreeNote (manifest.getEntries());
+    }
+
+    manifest.add (recorded);
+
+   #if JucePlugin_IsSynth
+    sampler.mapGenerations (manifest.getEntries());
+   #endif
+
+    return recorded.file;
+}
+
+void RadioPluginProcessor::importGeneration (const juce::File& downloaded, const juce::File& dest,
+                                             bool wantWav, const GenerationEntry& entry,
+                                             std::function<void (bool)> onDone)
+{
+    juce::WeakReference<RadioPluginProcessor> safeThis (this);
+
+    conversionEngine->importAsync (downloaded, dest, wantWav,
+        getPeaksDirectory().getChildFile (entry.peaksFile),
+        [safeThis, dest, entry, onDone] (ConversionEngine::Result result)
+        {
+            if (! result.ok && dest.getSize() == 0)
+                dest.deleteFile();   // release the reserved (still empty) name
+
+            if (safeThis == nullptr)
+                return;
+
+            if (result.ok)
+            {
+                auto recorded     = entry;
+                recorded.file     = result.file;
+                recorded.analysis = result.analysis;
+                safeThis->addGeneration (recorded);
+                safeThis->manifestReplaced.sendChangeMessage();
+            }
+
+            if (onDone) onDone (result.ok);
+        });
 }
 
 juce::AudioProcessorEditor* RadioPluginProcessor::createEditor()
@@ -26,20 +96,83 @@ juce::AudioProcessorEditor* RadioPluginProcessor::createEditor()
 }
 
 //==============================================================================
-// State: persist the plugin token so user doesn't re-enter it each session
+// Download / cache locations (shared by every plugin instance)
 //==============================================================================
+juce::File RadioPluginProcessor::getDownloadDirectory()
+{
+    // Use LOCALAPPDATA to avoid OneDrive file-locking issues
+    return juce::File::getSpecialLocation (juce::File::userApplicationDataDirectory)
+               .getChildFile ("444Radio")
+               .getChildFile ("Downloads");
+}
+
+juce::File RadioPluginProcessor::getPeaksDirectory()
+{
+    return getDownloadDirectory().getChildFile (".peaks");
+}
+
+//==============================================================================
+// State: plugin token + session manifest, in a compact binary chunk
+//
+//   "R444" magic, uint8 version, token (UTF-8), manifest (see SessionManifest)
+//
+// Projects saved by older builds hold a "Radio444State" XML blob — still read.
+//==============================================================================
+static constexpr char        kStateMagic[4] = { 'R', '4', '4', '4' };
+static constexpr juce::uint8 kStateVersion  = 1;
+
 void RadioPluginProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    auto xml = std::make_unique<juce::XmlElement> ("Radio444State");
-    xml->setAttribute ("token", pluginToken);
-    copyXmlToBinary (*xml, destData);
+    juce::MemoryOutputStream out (destData, false);
+    out.write (kStateMagic, sizeof (kStateMagic));
+    out.writeByte ((char) kStateVersion);
+    out.writeString (pluginToken);
+    manifest.writeTo (out);
 }
 
 void RadioPluginProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
+    if (sizeInBytes >= (int) sizeof (kStateMagic) + 1
+         && memcmp (data, kStateMagic, sizeof (kStateMagic)) == 0)
+    {
+        juce::MemoryInputStream in (data, (size_t) sizeInBytes, false);
+        in.skipNextBytes (sizeof (kStateMagic));
+
+        auto version = (juce::uint8) in.readByte();
+        if (version == 0 || version > kStateVersion)
+        {
+            DBG ("444 Radio: state version " + juce::String (version) + " not supported");
+            return;
+        }
+
+        pluginToken = in.readString();
+
+        // No manifest in the state means a project without generations —
+        // never keep the previous project's
+        if (in.isExhausted() || ! manifest.readFrom (in))
+            manifest.clear();
+
+        manifestStateLoaded();
+        return;
+    }
+
+    // Legacy XML state (token only) — predates the manifest
     auto xml = getXmlFromBinary (data, sizeInBytes);
     if (xml != nullptr && xml->hasTagName ("Radio444State"))
+    {
         pluginToken = xml->getStringAttribute ("token");
+        manifest.clear();
+        manifestStateLoaded();
+    }
+}
+
+void RadioPluginProcessor::manifestStateLoaded()
+{
+   #if JucePlugin_IsSynth
+    sampler.mapGenerations (manifest.getEntries());
+   #endif
+
+    manifestReplaced.sendChangeMessage();   // async — hosts call this from any thread
 }
 
 //==============================================================================
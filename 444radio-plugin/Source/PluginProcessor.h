@@ -2,6 +2,11 @@
 
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_audio_utils/juce_audio_utils.h>
+#include "SessionManifest.h"
+#include "ConnectionPool.h"
+#include "ConversionEngine.h"
+#include "Fingerprint.h"
+#include "SamplerEngine.h"
 
 //==============================================================================
 // 444 Radio Plugin — Audio Processor
@@ -9,6 +14,9 @@
 // This is a UTILITY plugin: audio passes through unchanged.
 // The plugin's purpose is to host the WebView UI for AI generation
 // and provide drag-drop of generated audio into Ableton.
+//
+// The instrument build (JucePlugin_IsSynth, "444 Radio Sampler") also maps
+// every generation onto a MIDI key and plays it from RAM.
 //==============================================================================
 class RadioPluginProcessor : public juce::AudioProcessor
 {
@@ -24,7 +32,7 @@ public:
     bool hasEditor() const override { return true; }
 
     const juce::String getName() const override { return JucePlugin_Name; }
-    bool acceptsMidi()  const override { return false; }
+    bool acceptsMidi()  const override { return JucePlugin_WantsMidiInput != 0; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
     double getTailLengthSeconds() const override { return 0.0; }
@@ -41,6 +49,53 @@ public:
     // Persisted plugin token (saved/restored with DAW project)
     juce::String pluginToken;
 
+    // Latest page state sent over the bridge — restores a hibernated or
+    // reopened editor's WebView without the user losing their place
+    juce::String pageSnapshot;
+
+    // Every generation imported into this project (saved/restored with it)
+    SessionManifest manifest { getDownloadDirectory() };
+
+    // Fires (on the message thread) when setStateInformation replaces the
+    // manifest or a background import adds to it, so an open editor can
+    // refresh its tray
+    juce::ChangeBroadcaster manifestReplaced;
+
+    // Records a generation in the manifest.  Audio already in the library is
+    // deduplicated first; returns the file the entry ended up pointing at.
+    // With `mapToSamplerKey`, the entry keeps the key of the entry it
+    // replaces, or gets the lowest free one (exported slices pass false).
+    juce::File addGeneration (const GenerationEntry&, bool mapToSamplerKey = true);
+
+    // Converts a finished download to `dest` on the shared pool, then
+    // records `entry` (file + analysis filled in) with addGeneration.  The
+    // processor owns this, so it completes even if the editor that started
+    // it has closed.  `onDone` runs on the message thread while the
+    // processor is alive.
+    void importGeneration (const juce::File& downloaded, const juce::File& dest, bool wantWav,
+                           const GenerationEntry& entry, std::function<void (bool)> onDone);
+
+    // Shared keep-alive HTTP session — lives while any plugin instance does
+    juce::SharedResourcePointer<ConnectionPool> connectionPool;
+
+    // Shared decode pool — conversions from every instance run side by side
+    juce::SharedResourcePointer<ConversionEngine> conversionEngine;
+
+    // Fingerprints of every file in the download folder, across projects
+    juce::SharedResourcePointer<FingerprintIndex> fingerprintIndex;
+
+    // ~/AppData/Roaming/444Radio/Downloads (or the platform equivalent)
+    static juce::File getDownloadDirectory();
+    static juce::File getPeaksDirectory();
+
 private:
+    // Sampler keys + open editors follow a manifest replaced by setStateInformation
+    void manifestStateLoaded();
+
+   #if JucePlugin_IsSynth
+    SamplerEngine sampler;
+   #endif
+
+    JUCE_DECLARE_WEAK_REFERENCEABLE (RadioPluginProcessor)
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RadioPluginProcessor)
 };
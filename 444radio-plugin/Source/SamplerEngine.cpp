@@ -0,0 +1,308 @@
+#include "SamplerEngine.h"
+#include "ConversionEngine.h"
+
+//==============================================================================
+SamplerEngine::SamplerEngine()
+{
+    for (auto& slot : keymap)
+        slot.store (nullptr);
+
+    startTimer (1000);
+}
+
+SamplerEngine::~SamplerEngine()
+{
+    stopTimer();
+    loadPool.removeAllJobs (true, 10000);
+}
+
+void SamplerEngine::prepare (double sampleRate)
+{
+    hostSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
+    releaseSamples = juce::jmax (1, juce::roundToInt (hostSampleRate * kReleaseMs / 1000.0));
+
+    for (auto& v : voices)
+        v.active = false;
+}
+
+//==============================================================================
+//  Audio thread
+//==============================================================================
+void SamplerEngine::render (juce::AudioBuffer<float>& buffer, const juce::MidiBuffer& midi)
+{
+    buffer.clear();
+
+    // A key remapped since the last block fades its voices out from here;
+    // the retired sample stays alive until they have finished.
+    for (auto& v : voices)
+        if (v.active && keymap[(size_t) v.note].load (std::memory_order_acquire) != v.sample)
+            releaseVoice (v);
+
+    const auto numSamples = buffer.getNumSamples();
+    int pos = 0;
+
+    for (const auto metadata : midi)
+    {
+        auto msg  = metadata.getMessage();
+        auto time = juce::jlimit (pos, numSamples, metadata.samplePosition);
+
+        renderVoices (buffer, pos, time - pos);
+        pos = time;
+
+        if (msg.isNoteOn())
+            startVoice (msg.getNoteNumber(), msg.getFloatVelocity());
+        else if (msg.isAllNotesOff() || msg.isAllSoundOff())
+            for (auto& v : voices)
+                releaseVoice (v);
+
+        // Note-off is ignored: generations play as one-shots
+    }
+
+    renderVoices (buffer, pos, numSamples - pos);
+
+    int onReplaced = 0;
+    for (auto& v : voices)
+        if (v.active && keymap[(size_t) v.note].load (std::memory_order_acquire) != v.sample)
+            ++onReplaced;
+
+    voicesOnReplacedSamples.store (onReplaced, std::memory_order_relaxed);
+    audioEpoch.fetch_add (1, std::memory_order_release);
+}
+
+void SamplerEngine::startVoice (int note, float velocity)
+{
+    if (! juce::isPositiveAndBelow (note, kNumNotes))
+        return;
+
+    auto* sample = keymap[(size_t) note].load (std::memory_order_acquire);
+    if (sample == nullptr || sample->audio.getNumSamples() == 0)
+        return;
+
+    // At most kMaxVoices sound at once: past that the oldest fades out in
+    // its slot, and the new voice takes a free one.  The pool has spare
+    // slots for fading voices; only if all are busy is the nearest-finished
+    // fade cut short.
+    Voice* free     = nullptr;
+    Voice* oldest   = nullptr;
+    Voice* quietest = nullptr;
+    int    sounding = 0;
+
+    for (auto& v : voices)
+    {
+        if (! v.active)
+        {
+            if (free == nullptr)
+                free = &v;
+        }
+        else if (v.releaseLeft > 0)
+        {
+            if (quietest == nullptr || v.releaseLeft < quietest->releaseLeft)
+                quietest = &v;
+        }
+        else
+        {
+            ++sounding;
+            if (oldest == nullptr || v.startedAt < oldest->startedAt)
+                oldest = &v;
+        }
+    }
+
+    auto* voice = free != nullptr ? free : quietest;
+    if (voice == nullptr)
+        voice = oldest;   // unreachable: sounding voices never fill the spare slots
+
+    if (sounding >= kMaxVoices && oldest != nullptr && oldest != voice)
+        releaseVoice (*oldest);
+
+    voice->sample      = sample;
+    voice->note        = note;
+    voice->position    = 0.0;
+    voice->increment   = sample->sampleRate / hostSampleRate;
+    voice->gain        = velocity;
+    voice->releaseLeft = 0;
+    voice->startedAt   = ++voiceCounter;
+    voice->active      = true;
+}
+
+void SamplerEngine::releaseVoice (Voice& v)
+{
+    if (v.active && v.releaseLeft == 0)
+        v.releaseLeft = releaseSamples;
+}
+
+void SamplerEngine::renderVoices (juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    if (numSamples <= 0)
+        return;
+
+    const auto numOut = buffer.getNumChannels();
+
+    for (auto& v : voices)
+    {
+        if (! v.active)
+            continue;
+
+        const auto& audio  = v.sample->audio;
+        const auto  length = audio.getNumSamples();
+        const auto  numIn  = audio.getNumChannels();
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto index = (int) v.position;
+            if (index + 1 >= length)
+            {
+                v.active = false;
+                break;
+            }
+
+            auto frac = (float) (v.position - (double) index);
+            auto gain = v.gain;
+
+            if (v.releaseLeft > 0)
+                gain *= (float) v.releaseLeft / (float) releaseSamples;
+
+            for (int ch = 0; ch < numOut; ++ch)
+            {
+                const auto* src = audio.getReadPointer (juce::jmin (ch, numIn - 1));
+                auto value = src[index] + frac * (src[index + 1] - src[index]);
+                buffer.addSample (ch, startSample + i, value * gain);
+            }
+
+            v.position += v.increment;
+
+            if (v.releaseLeft > 0 && --v.releaseLeft == 0)
+            {
+                v.active = false;
+                break;
+            }
+        }
+    }
+}
+
+//==============================================================================
+//  Loading (background) and publishing
+//==============================================================================
+void SamplerEngine::mapGenerations (const std::vector<GenerationEntry>& entries)
+{
+    std::array<juce::File, kNumNotes> wanted;
+    for (auto& e : entries)
+        if (juce::isPositiveAndBelow (e.midiNote, kNumNotes))
+            wanted[(size_t) e.midiNote] = e.file;
+
+    const juce::ScopedLock sl (loaderLock);
+
+    for (int note = 0; note < kNumNotes; ++note)
+    {
+        if (mappedFiles[(size_t) note] == wanted[(size_t) note])
+            continue;
+
+        mappedFiles[(size_t) note] = wanted[(size_t) note];
+
+        if (wanted[(size_t) note] == juce::File())
+            publish (note, {}, nullptr);
+        else
+            loadAsync (note, wanted[(size_t) note]);
+    }
+}
+
+int SamplerEngine::findFreeNote (const std::vector<GenerationEntry>& entries)
+{
+    std::array<bool, kNumNotes> used {};
+    for (auto& e : entries)
+        if (juce::isPositiveAndBelow (e.midiNote, kNumNotes))
+            used[(size_t) e.midiNote] = true;
+
+    for (int note = kFirstNote; note < kNumNotes; ++note)
+        if (! used[(size_t) note])
+            return note;
+
+    return -1;
+}
+
+void SamplerEngine::loadAsync (int note, const juce::File& file)
+{
+    loadPool.addJob ([this, note, file]
+    {
+        juce::AudioFormatManager fmtMgr;
+        ConversionEngine::registerFormats (fmtMgr);
+
+        std::unique_ptr<juce::AudioFormatReader> reader (fmtMgr.createReaderFor (file));
+        if (reader == nullptr || reader->lengthInSamples <= 0
+             || reader->lengthInSamples > std::numeric_limits<int>::max())
+        {
+            DBG ("444 Radio: sampler could not load " + file.getFullPathName());
+            return;
+        }
+
+        // Only the head of a long generation — a 3-minute song would be
+        // ~65 MB of floats per key
+        auto length = (int) juce::jmin (reader->lengthInSamples,
+                                        (juce::int64) (reader->sampleRate * kMaxSampleSeconds));
+
+        auto sample = std::make_unique<Sample>();
+        sample->sampleRate = reader->sampleRate;
+        sample->audio.setSize ((int) reader->numChannels, length);
+        reader->read (&sample->audio, 0, length, 0, true, true);
+
+        if (length < reader->lengthInSamples)
+        {
+            auto fade = juce::jmin (length, juce::roundToInt (reader->sampleRate * kReleaseMs / 1000.0));
+            sample->audio.applyGainRamp (length - fade, fade, 1.0f, 0.0f);
+        }
+
+        publish (note, file, std::move (sample));
+    });
+}
+
+void SamplerEngine::publish (int note, const juce::File& forFile, std::unique_ptr<Sample> sample)
+{
+    const juce::ScopedLock sl (loaderLock);
+
+    // The key was remapped while this file loaded — drop the stale sample
+    if (mappedFiles[(size_t) note] != forFile)
+        return;
+
+    if (sample != nullptr)
+    {
+        juce::int64 loaded = 0;
+        for (int other = 0; other < kNumNotes; ++other)
+            if (other != note && owned[(size_t) other] != nullptr)
+                loaded += getSizeInBytes (*owned[(size_t) other]);
+
+        if (loaded + getSizeInBytes (*sample) > kMaxLoadedBytes)
+        {
+            DBG ("444 Radio: sampler memory budget reached — key " + juce::String (note)
+                 + " left silent for " + forFile.getFileName());
+            sample.reset();
+        }
+    }
+
+    keymap[(size_t) note].store (sample.get(), std::memory_order_release);
+
+    if (owned[(size_t) note] != nullptr)
+        retired.push_back ({ std::move (owned[(size_t) note]),
+                             audioEpoch.load (std::memory_order_acquire) });
+
+    owned[(size_t) note] = std::move (sample);
+}
+
+juce::int64 SamplerEngine::getSizeInBytes (const Sample& sample)
+{
+    return (juce::int64) sample.audio.getNumChannels() * sample.audio.getNumSamples() * (juce::int64) sizeof (float);
+}
+
+void SamplerEngine::timerCallback()
+{
+    const juce::ScopedLock sl (loaderLock);
+    const auto now = audioEpoch.load (std::memory_order_acquire);
+
+    // A block that started after the swap (epoch + 2) has moved every voice
+    // on the old sample into its fade; once no voice on a replaced sample
+    // is left, none can read it again.
+    if (voicesOnReplacedSamples.load (std::memory_order_relaxed) > 0)
+        return;
+
+    retired.erase (std::remove_if (retired.begin(), retired.end(),
+                                   [now] (const Retired& r) { return now >= r.epoch + 2; }),
+                   retired.end());
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_events/juce_events.h>
+#include <array>
+#include <atomic>
+#include "SessionManifest.h"
+
+//==============================================================================
+// 444 Radio Plugin — Sampler Engine (instrument build only)
+//
+// Plays each generation on the MIDI key stored in its manifest entry
+// (assigned once at import, lowest free key from C1 up) as a one-shot from
+// RAM.  Keys never move when other entries are replaced or removed.
+//
+// Memory:        only the first kMaxSampleSeconds of a generation are
+//                loaded (a full song is sliced, not triggered whole), and
+//                all keys together stay under kMaxLoadedBytes.
+// Voices:        a stolen or remapped voice fades out over kReleaseMs in a
+//                spare release slot instead of being cut mid-waveform.
+//
+// Audio thread:  render() touches only the fixed voice pool and an array of
+//                atomic sample pointers — no locks, no allocation.
+// Loading:       files decode on a background thread; the finished sample
+//                is published with an atomic store.  Replaced samples are
+//                freed on the message thread once a whole audio block has
+//                run since the swap and no voice is still fading out on a
+//                replaced sample.
+//==============================================================================
+class SamplerEngine : private juce::Timer
+{
+public:
+    SamplerEngine();
+    ~SamplerEngine() override;
+
+    void prepare (double sampleRate);
+    void render (juce::AudioBuffer<float>&, const juce::MidiBuffer&);
+
+    // Loads any generation whose key/file changed and clears keys no entry
+    // uses any more; safe from any non-audio thread
+    void mapGenerations (const std::vector<GenerationEntry>&);
+
+    // Lowest key from kFirstNote up that no entry uses, or -1 when all are taken
+    static int findFreeNote (const std::vector<GenerationEntry>&);
+
+    static constexpr int kFirstNote    = 36;   // C1
+    static constexpr int kNumNotes     = 128;
+    static constexpr int kMaxVoices    = 64;   // sounding at once
+    static constexpr int kMaxReleasing = 16;   // extra slots for fading voices
+
+    static constexpr double      kMaxSampleSeconds = 30.0;
+    static constexpr juce::int64 kMaxLoadedBytes   = 512ll * 1024 * 1024;
+    static constexpr double      kReleaseMs        = 5.0;
+
+private:
+    struct Sample
+    {
+        juce::AudioBuffer<float> audio;
+        double                   sampleRate = 44100.0;
+    };
+
+    struct Voice
+    {
+        const Sample* sample    = nullptr;
+        int           note      = -1;
+        double        position  = 0.0;
+        double        increment = 1.0;
+        float         gain      = 0.0f;
+        int           releaseLeft = 0;   // > 0: fading out, samples to go
+        juce::uint32  startedAt = 0;
+        bool          active    = false;
+    };
+
+    struct Retired
+    {
+        std::unique_ptr<Sample> sample;
+        juce::uint64            epoch = 0;
+    };
+
+    void startVoice (int note, float velocity);
+    void releaseVoice (Voice&);
+    void renderVoices (juce::AudioBuffer<float>&, int startSample, int numSamples);
+    void loadAsync (int note, const juce::File&);
+    void publish (int note, const juce::File& forFile, std::unique_ptr<Sample>);
+    static juce::int64 getSizeInBytes (const Sample&);
+    void timerCallback() override;
+
+    // Audio-thread state
+    std::array<std::atomic<Sample*>, kNumNotes>   keymap;
+    std::array<Voice, kMaxVoices + kMaxReleasing> voices;
+    std::atomic<juce::uint64>                     audioEpoch { 0 };
+    std::atomic<int>                              voicesOnReplacedSamples { 0 };   // as of the last block
+    double                                        hostSampleRate = 44100.0;
+    int                                           releaseSamples = 220;
+    juce::uint32                                  voiceCounter = 0;
+
+    // Loader state — never touched by the audio thread
+    juce::CriticalSection                                loaderLock;
+    std::array<std::unique_ptr<Sample>, kNumNotes>       owned;
+    std::array<juce::File, kNumNotes>                    mappedFiles;
+    std::vector<Retired>                                 retired;
+    juce::ThreadPool                                     loadPool { 1 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SamplerEngine)
+};
@@ -0,0 +1,319 @@
+#include "SessionManifest.h"
+
+static constexpr char kManifestMagic[4] = { 'R', '4', 'M', 'F' };
+
+// Rebuild the log once replaced/removed records outnumber live ones
+static constexpr int kMinDeadRecordsBeforeCompaction = 16;
+
+//==============================================================================
+juce::uint64 GenerationEntry::makeCacheKey (const juce::String& url,
+                                            const juce::String& format)
+{
+    return (juce::uint64) (url.trim() + "|" + format.trim().toLowerCase()).hashCode64();
+}
+
+static constexpr char kPeaksMagic[4] = { 'R', '4', 'P', 'K' };
+
+//==============================================================================
+bool GenerationPeaks::write (const juce::File& dest, const std::vector<juce::uint8>& peaks)
+{
+    dest.getParentDirectory().createDirectory();
+
+    juce::FileOutputStream out (dest);
+    if (! out.openedOk())
+        return false;
+
+    out.setPosition (0);
+    out.truncate();
+    out.write (kPeaksMagic, sizeof (kPeaksMagic));
+    out.writeCompressedInt ((int) peaks.size());
+    out.write (peaks.data(), peaks.size());
+    out.flush();
+    return ! out.getStatus().failed();
+}
+
+std::vector<juce::uint8> GenerationPeaks::read (const juce::File& source)
+{
+    juce::FileInputStream in (source);
+    if (! in.openedOk())
+        return {};
+
+    char magic[4] = {};
+    if (in.read (magic, sizeof (magic)) != (int) sizeof (magic)
+         || memcmp (magic, kPeaksMagic, sizeof (magic)) != 0)
+        return {};
+
+    auto count = in.readCompressedInt();
+    if (count <= 0 || count > 1 << 20)
+        return {};
+
+    std::vector<juce::uint8> peaks ((size_t) count);
+    if (in.read (peaks.data(), count) != count)
+        return {};
+
+    return peaks;
+}
+
+//==============================================================================
+SessionManifest::SessionManifest (const juce::File& baseDirectory)
+    : baseDir (baseDirectory)
+{
+}
+
+void SessionManifest::add (const GenerationEntry& entry)
+{
+    const juce::ScopedLock sl (lock);
+
+    auto it = std::find_if (entries.begin(), entries.end(),
+                            [&] (const GenerationEntry& e) { return e.cacheKey == entry.cacheKey; });
+
+    if (it != entries.end())
+    {
+        entries.erase (it);
+        ++numDeadRecords;
+    }
+
+    entries.push_back (entry);
+    appendRecord (opAdd, encodeEntry (entry));
+    compactIfNeeded();
+}
+
+bool SessionManifest::remove (juce::uint64 cacheKey)
+{
+    const juce::ScopedLock sl (lock);
+
+    auto it = std::find_if (entries.begin(), entries.end(),
+                            [&] (const GenerationEntry& e) { return e.cacheKey == cacheKey; });
+
+    if (it == entries.end())
+        return false;
+
+    entries.erase (it);
+
+    juce::MemoryOutputStream payload;
+    payload.writeInt64 ((juce::int64) cacheKey);
+    appendRecord (opRemove, payload.getMemoryBlock());
+
+    numDeadRecords += 2;   // the original add and this remove
+    compactIfNeeded();
+    return true;
+}
+
+void SessionManifest::clear()
+{
+    const juce::ScopedLock sl (lock);
+    entries.clear();
+    log.reset();
+    numDeadRecords = 0;
+}
+
+std::optional<GenerationEntry> SessionManifest::find (juce::uint64 cacheKey) const
+{
+    const juce::ScopedLock sl (lock);
+
+    for (auto& e : entries)
+        if (e.cacheKey == cacheKey)
+            return e;
+
+    return std::nullopt;
+}
+
+std::vector<GenerationEntry> SessionManifest::getEntries() const
+{
+    const juce::ScopedLock sl (lock);
+    return entries;
+}
+
+int SessionManifest::size() const
+{
+    const juce::ScopedLock sl (lock);
+    return (int) entries.size();
+}
+
+//==============================================================================
+//  Serialisation
+//==============================================================================
+void SessionManifest::writeTo (juce::OutputStream& out) const
+{
+    const juce::ScopedLock sl (lock);
+    out.write (kManifestMagic, sizeof (kManifestMagic));
+    out.writeByte ((char) kVersion);
+    out.writeCompressedInt ((int) log.getSize());
+    out.write (log.getData(), log.getSize());
+}
+
+bool SessionManifest::readFrom (juce::InputStream& in)
+{
+    char magic[4] = {};
+    if (in.read (magic, sizeof (magic)) != (int) sizeof (magic)
+         || memcmp (magic, kManifestMagic, sizeof (magic)) != 0)
+        return false;
+
+    auto version = (juce::uint8) in.readByte();
+    if (version == 0 || version > kVersion)
+    {
+        DBG ("444 Radio: manifest version " + juce::String (version) + " not supported");
+        return false;
+    }
+
+    // A corrupt chunk must not be able to ask for a huge allocation
+    auto logSize   = in.readCompressedInt();
+    auto remaining = in.getNumBytesRemaining();
+    if (logSize < 0 || (remaining >= 0 && (juce::int64) logSize > remaining))
+    {
+        DBG ("444 Radio: manifest log size " + juce::String (logSize) + " exceeds the stored state");
+        return false;
+    }
+
+    juce::MemoryBlock stored;
+    stored.setSize ((size_t) logSize);
+    auto got = in.read (stored.getData(), logSize);
+    if (got < 0)
+        return false;
+    stored.setSize ((size_t) got);
+
+    const juce::ScopedLock sl (lock);
+    entries.clear();
+    log.reset();
+    numDeadRecords = 0;
+
+    juce::MemoryInputStream records (stored, false);
+    int numRecords = 0;
+
+    while (! records.isExhausted())
+    {
+        auto recordStart = records.getPosition();
+        auto op          = (Op) (juce::uint8) records.readByte();
+        auto size        = records.readCompressedInt();
+
+        if (size < 0 || records.getNumBytesRemaining() < size)
+            break;   // truncated tail — keep what we have
+
+        juce::MemoryBlock payload;
+        records.readIntoMemoryBlock (payload, size);
+
+        juce::MemoryInputStream payloadStream (payload, false);
+        applyRecord (op, payloadStream, version);
+        ++numRecords;
+
+        log.append (stored.begin() + recordStart, (size_t) (records.getPosition() - recordStart));
+    }
+
+    numDeadRecords = numRecords - (int) entries.size();
+
+    if (version < 3)
+        for (size_t i = 0; i < entries.size() && kLegacyFirstNote + (int) i < 128; ++i)
+            entries[i].midiNote = kLegacyFirstNote + (int) i;
+
+    // Older records lack newer fields — re-encode so the log is one version
+    if (version < kVersion)
+        rebuildLog();
+    else
+        compactIfNeeded();
+
+    DBG ("444 Radio: manifest restored — " + juce::String ((int) entries.size()) + " generations");
+    return true;
+}
+
+//==============================================================================
+void SessionManifest::appendRecord (Op op, const juce::MemoryBlock& payload)
+{
+    juce::MemoryOutputStream out (log, true);
+    out.writeByte ((char) op);
+    out.writeCompressedInt ((int) payload.getSize());
+    out.write (payload.getData(), payload.getSize());
+}
+
+void SessionManifest::applyRecord (Op op, juce::MemoryInputStream& payload, juce::uint8 version)
+{
+    if (op == opAdd)
+    {
+        auto entry = decodeEntry (payload, version);
+        entries.erase (std::remove_if (entries.begin(), entries.end(),
+                                       [&] (const GenerationEntry& e) { return e.cacheKey == entry.cacheKey; }),
+                       entries.end());
+        entries.push_back (std::move (entry));
+    }
+    else if (op == opRemove)
+    {
+        auto key = (juce::uint64) payload.readInt64();
+        entries.erase (std::remove_if (entries.begin(), entries.end(),
+                                       [&] (const GenerationEntry& e) { return e.cacheKey == key; }),
+                       entries.end());
+    }
+    // Unknown ops from newer minor revisions are ignored
+}
+
+void SessionManifest::compactIfNeeded()
+{
+    if (numDeadRecords < kMinDeadRecordsBeforeCompaction
+         || numDeadRecords < (int) entries.size())
+        return;
+
+    rebuildLog();
+}
+
+void SessionManifest::rebuildLog()
+{
+    log.reset();
+    for (auto& e : entries)
+        appendRecord (opAdd, encodeEntry (e));
+
+    numDeadRecords = 0;
+}
+
+juce::MemoryBlock SessionManifest::encodeEntry (const GenerationEntry& e) const
+{
+    // Files under the download folder are stored relative to it — shorter,
+    // and survives the user's profile folder being renamed.
+    auto path = e.file.isAChildOf (baseDir) ? e.file.getRelativePathFrom (baseDir)
+                                            : e.file.getFullPathName();
+
+    juce::MemoryOutputStream out;
+    out.writeInt64 ((juce::int64) e.cacheKey);
+    out.writeString (e.title);
+    out.writeString (e.sourceUrl);
+    out.writeString (e.format);
+    out.writeString (path);
+    out.writeString (e.peaksFile);
+    out.writeInt64 (e.importedAt);
+    out.writeDouble (e.analysis.sampleRate);
+    out.writeCompressedInt (e.analysis.numChannels);
+    out.writeInt64 (e.analysis.lengthInSamples);
+    out.writeFloat (e.analysis.peakLevel);
+    out.writeFloat (e.analysis.rmsLevel);
+    out.writeInt64 ((juce::int64) e.analysis.contentHash);
+    for (auto word : e.analysis.fingerprint)
+        out.writeInt64 ((juce::int64) word);
+    out.writeCompressedInt (e.midiNote);
+    return out.getMemoryBlock();
+}
+
+GenerationEntry SessionManifest::decodeEntry (juce::InputStream& in, juce::uint8 version) const
+{
+    GenerationEntry e;
+    e.cacheKey                 = (juce::uint64) in.readInt64();
+    e.title                    = in.readString();
+    e.sourceUrl                = in.readString();
+    e.format                   = in.readString();
+    e.file                     = baseDir.getChildFile (in.readString());
+    e.peaksFile                = in.readString();
+    e.importedAt               = in.readInt64();
+    e.analysis.sampleRate      = in.readDouble();
+    e.analysis.numChannels     = in.readCompressedInt();
+    e.analysis.lengthInSamples = in.readInt64();
+    e.analysis.peakLevel       = in.readFloat();
+    e.analysis.rmsLevel        = in.readFloat();
+
+    if (version >= 2)
+    {
+        e.analysis.contentHash = (juce::uint64) in.readInt64();
+        for (auto& word : e.analysis.fingerprint)
+            word = (juce::uint64) in.readInt64();
+    }
+
+    if (version >= 3)
+        e.midiNote = in.readCompressedInt();
+
+    return e;
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <optional>
+#include <vector>
+
+//==============================================================================
+// 444 Radio Plugin — Session Manifest
+//
+// Records every generation imported into the project (cache key, file,
+// peaks sidecar, analysis) and is saved with the processor state, so a
+// reopened project gets its clip history back without touching the network.
+//
+// Binary layout:  "R4MF" magic, uint8 version, then an append-only log of
+//                 records  [uint8 op][compressed-int size][payload].
+// New imports append one record; saving copies the log as-is instead of
+// re-serialising every entry.  Unknown ops are skipped by size.
+//==============================================================================
+// 256-bit spectral fingerprint: 16 log-spaced bands x 16 time cells, one bit
+// per cell (above/below that band's median).  See Fingerprint.h.
+using AudioFingerprint = std::array<juce::uint64, 4>;
+
+struct GenerationAnalysis
+{
+    double           sampleRate      = 0.0;
+    int              numChannels     = 0;
+    juce::int64      lengthInSamples = 0;
+    float            peakLevel       = 0.0f;
+    float            rmsLevel        = 0.0f;
+    juce::uint64     contentHash     = 0;    // hash of the decoded samples
+    AudioFingerprint fingerprint     {};
+
+    double getLengthInSeconds() const
+    {
+        return sampleRate > 0.0 ? (double) lengthInSamples / sampleRate : 0.0;
+    }
+};
+
+struct GenerationEntry
+{
+    juce::uint64       cacheKey = 0;
+    juce::String       title;
+    juce::String       sourceUrl;
+    juce::String       format;
+    juce::File         file;
+    juce::String       peaksFile;      // file name inside the peaks cache folder
+    juce::int64        importedAt = 0; // ms since epoch
+    int                midiNote = -1;  // sampler key, kept for the entry's lifetime (-1 = none)
+    GenerationAnalysis analysis;
+
+    // Same URL + same requested format → same cache key
+    static juce::uint64 makeCacheKey (const juce::String& url, const juce::String& format);
+};
+
+//==============================================================================
+// Peaks sidecar: one uint8 max-abs level per bucket, written once at import
+// so waveforms can be drawn without decoding audio again.
+//==============================================================================
+namespace GenerationPeaks
+{
+    constexpr int kResolution = 1024;
+
+    bool                      write (const juce::File&, const std::vector<juce::uint8>& peaks);
+    std::vector<juce::uint8>  read  (const juce::File&);
+}
+
+//==============================================================================
+class SessionManifest
+{
+public:
+    explicit SessionManifest (const juce::File& baseDirectory);
+
+    // Adds an entry, replacing any existing entry with the same cache key
+    void add (const GenerationEntry&);
+    bool remove (juce::uint64 cacheKey);
+    void clear();
+
+    std::optional<GenerationEntry> find (juce::uint64 cacheKey) const;
+    std::vector<GenerationEntry>   getEntries() const;   // import order
+    int size() const;
+
+    void writeTo (juce::OutputStream&) const;
+    bool readFrom (juce::InputStream&);
+
+    static constexpr juce::uint8 kVersion = 3;   // v2: content hash + fingerprint, v3: MIDI note
+
+    // Before v3, entry i played on C1 + i; restored projects keep those keys
+    static constexpr int kLegacyFirstNote = 36;
+
+private:
+    enum Op : juce::uint8 { opAdd = 1, opRemove = 2 };
+
+    void appendRecord (Op, const juce::MemoryBlock& payload);
+    void applyRecord (Op, juce::MemoryInputStream& payload, juce::uint8 version);
+    void compactIfNeeded();
+    void rebuildLog();
+
+    juce::MemoryBlock encodeEntry (const GenerationEntry&) const;
+    GenerationEntry   decodeEntry (juce::InputStream&, juce::uint8 version) const;
+
+    juce::File                   baseDir;   // file paths are stored relative to this
+    mutable juce::CriticalSection lock;
+    std::vector<GenerationEntry> entries;
+    juce::MemoryBlock            log;
+    int                          numDeadRecords = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SessionManifest)
+};
@@ -725,6 +725,74 @@ function PluginPageInner() {
     sendBridgeMessage({ action: 'import_video', url, title: safeName, format: 'mp4' })
   }
 
+  // ═══ DAW BRIDGE: C++ → page (#juce=<json>), snapshots for WebView hibernation ═══
+  // The plugin drops a hidden editor's browser only after a snapshot that
+  // reports the page idle, and hands the last snapshot back as #restore=.
+  const pageUrl = () => window.location.href.split('#')[0]
+  const snapshotRef = useRef<() => Record<string, unknown>>(() => ({}))
+  snapshotRef.current = () => ({
+    action: 'state_snapshot',
+    url: pageUrl(),
+    idle: activeGenerations.size === 0,
+    state: { input, selectedType, customTitle, customLyrics, genre, bpm, isInstrumental },
+  })
+
+  // Restore state saved before hibernation / editor close
+  useEffect(() => {
+    if (!isInDAW) return
+    const hash = window.location.hash
+    if (hash.startsWith('#restore=')) {
+      try {
+        const state = JSON.parse(decodeURIComponent(hash.slice('#restore='.length)))
+        if (typeof state.input === 'string') setInput(state.input)
+        if (['music', 'image', 'video', 'effects'].includes(state.selectedType)) setSelectedType(state.selectedType)
+        if (typeof state.customTitle === 'string') setCustomTitle(state.customTitle)
+        if (typeof state.customLyrics === 'string') setCustomLyrics(state.customLyrics)
+        if (typeof state.genre === 'string') setGenre(state.genre)
+        if (typeof state.bpm === 'string') setBpm(state.bpm)
+        if (typeof state.isInstrumental === 'boolean') setIsInstrumental(state.isInstrumental)
+      } catch (e) {
+        console.warn('[plugin] Could not restore state:', e)
+      }
+      history.replaceState(history.state, '', pageUrl())
+    }
+    // Messages from C++ go to this exact URL — report it
+    sendBridgeMessage({ action: 'page_url', url: pageUrl() })
+    // eslint-disable-next-line react-hooks/exhaustive-deps
+  }, [isInDAW])
+
+  // Messages from C++ arrive as fragment navigations
+  useEffect(() => {
+    if (!isInDAW) return
+    const onHashChange = () => {
+      const hash = window.location.hash
+      if (!hash.startsWith('#juce=')) return
+      history.replaceState(history.state, '', pageUrl())
+      let msg: any
+      try { msg = JSON.parse(decodeURIComponent(hash.slice('#juce='.length))) } catch { return }
+      if (msg?.event === 'snapshot_request') {
+        sendBridgeMessage(snapshotRef.current())
+      } else if (msg?.event) {
+        // metrics / benchmark_results / similar_results / region_exported
+        window.dispatchEvent(new CustomEvent('juce-message', { detail: msg }))
+      }
+    }
+    const onPopState = () => sendBridgeMessage({ action: 'page_url', url: pageUrl() })
+    window.addEventListener('hashchange', onHashChange)
+    window.addEventListener('popstate', onPopState)
+    return () => {
+      window.removeEventListener('hashchange', onHashChange)
+      window.removeEventListener('popstate', onPopState)
+    }
+    // eslint-disable-next-line react-hooks/exhaustive-deps
+  }, [isInDAW])
+
+  // A generation starting or finishing changes `idle` — tell the plugin
+  useEffect(() => {
+    if (isInDAW) sendBridgeMessage(snapshotRef.current())
+    // eslint-disable-next-line react-hooks/exhaustive-deps
+  }, [isInDAW, activeGenerations])
+
   // ═══ PROXY FETCH — always go through same-domain proxy for CORS safety ═══
   const proxyFetch = async (url: string): Promise<Response> => {
     try {